@@ -0,0 +1,4 @@
+#include "1.h"
+#include "Registry.h"
+
+static Registration<1, One> const registration{__DATE__ " " __TIME__};
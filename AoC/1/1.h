@@ -1,56 +1,120 @@
 #pragma once
 
 #include <algorithm>
+#include <map>
 #include <vector>
 #include <ranges>
-#include "input.h"
+#include "Input.h"
 
-class One : public Puzzle
+struct OneData
+{
+	std::vector<int> left;
+	std::vector<int> right;
+};
+
+inline std::pair<int, int> parseLocationIds(std::string_view const line)
+{
+	auto const [left, right] = scanNumbers<2, int>(line);
+	return {left, right};
+}
+
+// Streams the lists as counts per location ID, which are few compared to the number of lines
+class OneAccumulator : public Accumulator
 {
 public:
-	One() : Puzzle(1)
+	void add(std::string_view const line) override
 	{
+		auto const [left, right] = parseLocationIds(line);
+		++leftCounts[left];
+		++rightCounts[right];
 	}
 
-	void parse(auto const& input, auto& left, auto& right)
+	// Pairs the sorted lists by walking both count maps in order
+	std::optional<long long> partOne() const override
 	{
-		for (auto const& line : input)
+		auto distance = 0ll;
+		auto rightIt = rightCounts.begin();
+		auto rightLeft = rightIt == rightCounts.end() ? 0 : rightIt->second;
+		for (auto const& [id, count] : leftCounts)
 		{
-			auto splitLine = split(line, "   ");
-			left.push_back(std::stoi(splitLine[0]));
-			right.push_back(std::stoi(splitLine[1]));
+			for (auto leftLeft = count; leftLeft > 0 && rightIt != rightCounts.end();)
+			{
+				auto const pairs = (std::min)(leftLeft, rightLeft);
+				distance += pairs * std::abs(id - rightIt->first);
+				leftLeft -= pairs;
+				rightLeft -= pairs;
+				if (rightLeft == 0 && ++rightIt != rightCounts.end())
+					rightLeft = rightIt->second;
+			}
 		}
+		return distance;
 	}
 
-	long long partOne(const Input& input) override
+	std::optional<long long> partTwo() const override
+	{
+		auto similarity = 0ll;
+		for (auto const& [id, count] : leftCounts)
+			if (auto const it = rightCounts.find(id); it != rightCounts.end())
+				similarity += id * count * it->second;
+		return similarity;
+	}
+
+private:
+	std::map<int, long long> leftCounts;
+	std::map<int, long long> rightCounts;
+};
+
+class One : public ParsedPuzzle<OneData>
+{
+public:
+	One() : ParsedPuzzle(1)
 	{
-		std::vector<int> left;
-		std::vector<int> right;
+	}
 
-		parse(input.lines, left, right);
+	// size lines of location ID pairs
+	static void generate(Generator& generator)
+	{
+		for ([[maybe_unused]] auto _ : range(generator.size()))
+			generator << generator.number(10000, 99999) << "   " << generator.number(10000, 99999) << '\n';
+	}
 
-		std::ranges::sort(left);
-		std::ranges::sort(right);
+	std::unique_ptr<Accumulator> createAccumulator() const
+	{
+		return std::make_unique<OneAccumulator>();
+	}
 
-		auto const size = left.size();
-		auto distance = 0;
-		for (auto i = 0; i < size; i++)
+	OneData parse(Input const& input) override
+	{
+		OneData data;
+		for (auto const& line : input.lines)
 		{
-			distance += std::abs(left[i] - right[i]);
+			auto const [left, right] = parseLocationIds(line);
+			data.left.push_back(left);
+			data.right.push_back(right);
 		}
-		return distance;
+
+		std::ranges::sort(data.left);
+		std::ranges::sort(data.right);
+		return data;
 	}
 
-	long long partTwo(const Input& input) override
+	long long partOne(OneData const& data) override
 	{
-		std::vector<int> left;
-		std::vector<int> right;
+		auto const& left = data.left;
+		auto const& right = data.right;
 
-		parse(input.lines, left, right);
+		auto distance = 0ll;
+		for (auto const i : range(left.size()))
+			distance += std::abs(left[i] - right[i]);
+		return distance;
+	}
 
-		auto count = 0;
-		for (auto const& num : left)
-			count += num * std::ranges::count(right, num);
+	long long partTwo(OneData const& data) override
+	{
+		// right is sorted, so the matches of each number are one run of it
+		auto count = 0ll;
+		for (auto const& num : data.left)
+			count += static_cast<long long>(num) * std::ranges::equal_range(data.right, num).size();
 		return count;
 	}
 };
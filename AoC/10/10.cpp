@@ -0,0 +1,4 @@
+#include "10.h"
+#include "Registry.h"
+
+static Registration<10, Ten> const registration{__DATE__ " " __TIME__};
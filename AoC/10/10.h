@@ -1,124 +1,118 @@
 #pragma once
-#include <set>
-
 #include "Input.h"
 
 
 class TopographicMap : public Grid
 {
 public:
-	TopographicMap(std::vector<std::string> const& input)
-		: Grid(input, true)
+	TopographicMap(std::vector<std::string_view> const& input)
+		: Grid(input, true, '.')
 	{
 	}
 
-	std::vector<std::vector<Location>> getTrailheads()
+	std::vector<int> getTrailheads() const
 	{
-		std::vector<std::vector<Location>> trailheads;
+		std::vector<int> trailheads;
 		for (auto const y : range(yMax()))
 			for (auto const x : range(xMax()))
-				if (get(y, x).intValue == 0)
-					trailheads.push_back({get(y, x).location});
+				if (value(y, x) == 0)
+					trailheads.push_back(states.id({y, x}));
 		return trailheads;
 	}
 
-	std::vector<Location> getMoves(Coordinate const& current)
+	// The border reads as -1, so no step leaves the map
+	auto getMoves(Location const& current) const
 	{
-		std::vector<Location> moves;
-		std::vector<Location> const steps = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-
-		for (auto const& step : steps)
-			if (boundsCheck(current, step) && get(current, step).intValue == (current.intValue + 1))
-				moves.push_back(get(current, step).location);
-		return moves;
+		return orthogonalMoves |
+			std::views::transform([current](Location const& step) { return current.move(step); }) |
+			std::views::filter([this, next = value(current) + 1](Location const& location)
+			{
+				return value(location) == next;
+			});
 	}
 
-	bool trailFinished(std::vector<Location> const& trail)
+	// A trail climbs one step at a time, so every trail to a cell is a shortest path to it
+	void forEachStep(int const state, auto&& step) const
 	{
-		return get(trail.back()).intValue == 9;
+		for (auto const& next : getMoves(states.location(state)))
+			step(states.id(next), 1);
 	}
 
-
-	bool trailsFinished(std::vector<std::vector<Location>> const& trails)
+	int countSummits(GraphSearch const& search) const
 	{
-		for (auto const& trail : trails)
-			if (!trailFinished(trail))
-				return false;
-		return true;
+		return static_cast<int>(std::ranges::count_if(search.settledStates(), [this](int const state)
+		{
+			return value(states.location(state)) == 9;
+		}));
 	}
 
-	std::vector<std::vector<Location>> getMoves(std::vector<std::vector<Location>> const& trails)
+	// The summits reachable from each trailhead, added up
+	int getScore() const
 	{
-		std::vector<std::vector<Location>> newTrails;
-		for (auto const& trail : trails)
+		GraphSearch search{states.size()};
+		auto score = 0;
+		for (auto const trailhead : getTrailheads())
 		{
-			if (trailFinished(trail))
-			{
-				newTrails.push_back(trail);
-				continue;
-			}
-
-			for (auto const& move : getMoves(get(trail.back())))
-			{
-				auto newTrail = trail;
-				newTrail.push_back(move);
-				newTrails.push_back(newTrail);
-			}
+			int const start[] = {trailhead};
+			search.bfs(start, [this](int const state, auto&& step) { forEachStep(state, step); });
+			score += countSummits(search);
 		}
-		return newTrails;
-	}
-
-	std::vector<std::vector<Location>> getTrails()
-	{
-		std::vector<std::vector<Location>> trails = getTrailheads();
-		while (!trailsFinished(trails))
-			trails = getMoves(trails);
-		return trails;
-	}
-
-	int getScore()
-	{
-		std::map<Location, std::set<Location>> trailheadToEnds;
-		for (auto const& trail : getTrails())
-			trailheadToEnds[trail.front()].insert(trail.back());
-
-		int score = 0;
-		for (auto const& ends : trailheadToEnds | std::views::values)
-			score += ends.size();
-
 		return score;
 	}
 
-	int getRating()
+	// All trails from any trailhead to any summit
+	long long getRating() const
 	{
-		return getTrails().size();
+		GraphSearch search{states.size(), true};
+		search.bfs(getTrailheads(), [this](int const state, auto&& step) { forEachStep(state, step); });
+		auto const counts = search.countShortestPaths();
+		auto rating = 0ll;
+		for (auto const state : search.settledStates())
+			if (value(states.location(state)) == 9)
+				rating += counts[state];
+		return rating;
 	}
+
+private:
+	GridStates states{xMax(), yMax()};
 };
 
 
-class Ten : public Puzzle
+class Ten : public ParsedPuzzle<TopographicMap>
 {
 public:
 	explicit Ten()
-		: Puzzle(10)
+		: ParsedPuzzle(10)
+	{
+	}
+
+	// Square map of about size cells. Heights rise diagonally with some noise, so there are plenty of trails.
+	static void generate(Generator& generator)
 	{
+		auto const side = generator.side();
+		for (auto const y : range(side))
+		{
+			for (auto const x : range(side))
+			{
+				auto const noise = generator.chance(0.1) ? generator.number(1, 9) : 0;
+				generator << static_cast<char>('0' + (y + x + noise) % 10);
+			}
+			generator << '\n';
+		}
 	}
 
-	long long partOne(const Input& input) override
+	TopographicMap parse(const Input& input) override
 	{
-		if (input.lines.empty())
-			return -1;
+		return TopographicMap{input.lines};
+	}
 
-		auto topographicMap = TopographicMap{input.lines};
+	long long partOne(TopographicMap const& topographicMap) override
+	{
 		return topographicMap.getScore();
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(TopographicMap const& topographicMap) override
 	{
-		if (input.lines.empty())
-			return -1;
-
-		auto topographicMap = TopographicMap{input.lines};
 		return topographicMap.getRating();
 	}
 };
@@ -0,0 +1,4 @@
+#include "11.h"
+#include "Registry.h"
+
+static Registration<11, Eleven> const registration{__DATE__ " " __TIME__};
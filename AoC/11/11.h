@@ -1,5 +1,6 @@
 #pragma once
 #include <cassert>
+#include <shared_mutex>
 #include <unordered_set>
 
 #include "Input.h"
@@ -42,23 +43,35 @@ public:
 
 	std::vector<Stone> const& cachedBlink() const
 	{
+		// Shared by all parts, which may run at the same time. Elements don't move when the map grows.
+		static std::shared_mutex mutex;
 		static std::unordered_map<long long, std::vector<Stone>> cache{};
-		auto& cacheItem = cache[value];
-		if (!cacheItem.empty())
-			return cacheItem;
+		{
+			std::shared_lock lock(mutex);
+			if (auto const it = cache.find(value); it != cache.end())
+			{
+				blinkCacheHits.add();
+				return it->second;
+			}
+		}
 
-		cacheItem = blink();
-		return cacheItem;
+		blinkCacheMisses.add();
+		auto stones = blink();
+		std::unique_lock lock(mutex);
+		return cache.try_emplace(value, std::move(stones)).first->second;
 	}
 
 	long long value;
+
+	static inline Instrumentation::Counter const blinkCacheHits{"blink cache hits"};
+	static inline Instrumentation::Counter const blinkCacheMisses{"blink cache misses"};
 };
 
 inline auto parseStones(Input const& input)
 {
 	std::vector<Stone> result;
-	for (auto const& part : split(input.lines[0], " "))
-		result.push_back({stoll(part)});
+	for (auto const value : scanNumbers(input.lines[0]))
+		result.push_back({value});
 	return result;
 }
 
@@ -67,6 +80,7 @@ class StoneCache
 public:
 	static void init(int const blinks)
 	{
+		std::unique_lock lock(mutex);
 		for (auto const calcBlinks : range(1, blinks + 1))
 		{
 			if (map.contains(calcBlinks))
@@ -74,7 +88,7 @@ public:
 
 			for (auto const startNum : range(10))
 			{
-				std::cout << startNum << calcBlinks << std::endl;
+				log<Verbosity::Trace>("stone cache {} after {} blinks\n", startNum, calcBlinks);
 				calc(startNum, calcBlinks);
 			}
 		}
@@ -93,9 +107,12 @@ public:
 			{
 				if (map.contains(stone.value) && map[stone.value].contains(remainingBlinks))
 				{
+					StoneCache::hits.add();
 					carry += map[stone.value].at(remainingBlinks);
 					foundInCache.insert(stone.value);
 				}
+				else
+					StoneCache::misses.add();
 			}
 
 			for (auto const& stoneValue : foundInCache)
@@ -109,6 +126,10 @@ public:
 	}
 
 	static inline std::unordered_map<long long, std::unordered_map<int, long long>> map{};
+	// Filled by init, read by Stones::cachedBlink, both from parts that may run at the same time
+	static inline std::shared_mutex mutex;
+	static inline Instrumentation::Counter const hits{"stone cache hits"};
+	static inline Instrumentation::Counter const misses{"stone cache misses"};
 };
 
 class Stones
@@ -129,6 +150,7 @@ public:
 	long long cachedBlink(int blinks)
 	{
 		StoneCache::init(blinks);
+		std::shared_lock lock(StoneCache::mutex);
 		auto carry = 0ll;
 		for (auto const i : range(1, blinks + 1))
 		{
@@ -138,10 +160,13 @@ public:
 			{
 				if (StoneCache::map.contains(stone.value) && StoneCache::map.at(stone.value).contains(remainingBlinks))
 				{
+					StoneCache::hits.add();
 					foundInCache.insert(stone.value);
 					carry += StoneCache::map.at(stone.value).at(remainingBlinks);
 					assert(carry > 0);
 				}
+				else
+					StoneCache::misses.add();
 			}
 
 			for (auto const& toRemove : foundInCache)
@@ -178,6 +203,13 @@ public:
 	{
 	}
 
+	// size stones
+	static void generate(Generator& generator)
+	{
+		for (auto const index : range(generator.size()))
+			generator << generator.number(0, 999999) << (index + 1 < generator.size() ? ' ' : '\n');
+	}
+
 	long long partOne(const Input& input) override
 	{
 		if (input.lines.empty())
@@ -0,0 +1,4 @@
+#include "12.h"
+#include "Registry.h"
+
+static Registration<12, Twelve> const registration{__DATE__ " " __TIME__};
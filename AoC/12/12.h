@@ -4,202 +4,125 @@
 class Farm : public Grid
 {
 public:
-	Farm(std::vector<std::string> const& input)
-		: Grid(input, false)
+	Farm(std::vector<std::string_view> const& input)
+		: Grid(input, false),
+		  regions(ComponentLabels::parallel(*this))
 	{
-		std::set<Location> seen;
-		for (auto const& line : data)
-		{
-			for (auto const& coordinate : line)
-			{
-				if (seen.contains(coordinate.location))
-					continue;
-
-
-				std::set<Location> group{{coordinate.location}};
-				expandGroup(coordinate, group);
-				seen.insert_range(group);
-				regions.push_back(group);
-			}
-		}
 	}
 
-	void expandGroup(Coordinate const& coordinate, std::set<Location>& group)
+	bool inRegion(Location const& location, int const region) const
 	{
-		for (auto const& neighbour : getSurroundingCoordinates(coordinate))
-		{
-			if (group.contains(neighbour->location) || coordinate.strValue != neighbour->strValue)
-				continue;
-
-			group.insert(neighbour->location);
-			expandGroup(*neighbour, group);
-		}
+		return boundsCheck(location) && regions.label(location) == region;
 	}
 
-	long long getFencingPriceForRegion(std::set<Location> const& region)
+	long long getPrice(std::vector<long long> const& fencesPerRegion) const
 	{
-		auto numFences = 0ll;
-		std::string regionStr;
-		for (auto const& location : region)
+		auto price = 0ll;
+		for (auto const region : range(regions.count()))
 		{
-			auto const& coordinate = get(location);
-			regionStr = coordinate.strValue;
-			auto numNeigbours = 0;
-			for (auto const& neighbour : getSurroundingCoordinates(coordinate))
-				if (!region.contains(neighbour->location))
-					++numNeigbours;
-			if (coordinate.x() == 0 || coordinate.x() == (xMax() - 1))
-				++numNeigbours;
-			if (coordinate.y() == 0 || coordinate.y() == (yMax() - 1))
-				++numNeigbours;
-			numFences += numNeigbours;
+			log<Verbosity::Trace>("\nRegion {} of size {} has {} fences\n", get(*regions.cells(region).begin()),
+			                      regions.area(region), fencesPerRegion[region]);
+			price += fencesPerRegion[region] * regions.area(region);
 		}
-
-		std::cout << std::format("\nRegion {} of size {} has {} fences\n", regionStr, region.size(), numFences);
-
-		return numFences * region.size();
-	}
-
-	long long getTotalFencingPrice()
-	{
-		auto price = 0ll;
-		for (auto const& region : regions)
-			price += getFencingPriceForRegion(region);
 		return price;
 	}
 
-	long long getDiscountedFencingPriceForRegion(std::set<Location> const& region)
+	// A fence on every side of a plot that doesn't face its own region
+	long long getTotalFencingPrice() const
 	{
-		std::map<Location, Location> verticalFences;
-		std::map<Location, Location> horizontalFences;
-
-		for (auto const& location : region)
-		{
-			auto& coordinate = get(location);
-
-			auto check = [&](auto& set, auto const dLocation)
-			{
-				auto const newLocation = location.move(dLocation);
-				if (!boundsCheck(coordinate, dLocation) || !region.contains(newLocation))
-				{
-					auto moveFenceLocation = dLocation;
-					if (moveFenceLocation.first < 0)
-						moveFenceLocation.first = 0;
-					if (moveFenceLocation.second < 0)
-						moveFenceLocation.second = 0;
-					set[location.move(moveFenceLocation)] = dLocation;
-				}
-			};
-
-			check(horizontalFences, Location{-1, 0});
-			check(horizontalFences, Location{1, 0});
-			check(verticalFences, Location{0, 1});
-			check(verticalFences, Location{0, -1});
-		}
-
-		auto sidesCount = 0ll;
-
-
-		for (auto const x : range(-1, xMax() + 1))
+		std::vector<long long> fences(regions.count());
+		for (auto const location : locations())
 		{
-			bool line = false;
-			for (auto const y : range(-1, yMax() + 1))
-			{
-				auto const location = Location{y, x};
-				auto const prevLocation = location.move({-1, 0});
-				if (!verticalFences.contains(location))
-				{
-					line = false;
-					continue;
-				}
-
-				if (line && verticalFences[location] != verticalFences[prevLocation])
-					++sidesCount; // new line in other direction
-
-				if (!line)
-					++sidesCount;
-				line = true;
-			}
+			auto const region = regions.label(location);
+			for (auto const& move : orthogonalMoves)
+				if (!inRegion(location.move(move), region))
+					++fences[region];
 		}
+		return getPrice(fences);
+	}
 
-		for (auto const y : range(-1, yMax() + 1))
+	// A region has as many sides as corners. A plot makes an outer corner towards a diagonal when neither plot next
+	// to it on that side is in its region, and an inner corner when both are but the diagonal plot isn't.
+	long long getTotalDiscountedFencingPrice() const
+	{
+		std::vector<long long> sides(regions.count());
+		for (auto const location : locations())
 		{
-			bool line = false;
-			for (auto const x : range(-1, xMax() + 1))
+			auto const region = regions.label(location);
+			for (auto const& diagonal : diagonalMoves)
 			{
-				auto const location = Location{y, x};
-				auto const prevLocation = location.move({0, -1});
-				if (!horizontalFences.contains(location))
-				{
-					line = false;
-					continue;
-				}
-
-				if (line && horizontalFences[location] != horizontalFences[prevLocation])
-					++sidesCount; // new line in other direction
-
-				if (!line)
-					++sidesCount;
-				line = true;
+				auto const vertical = inRegion(location.move({diagonal.y(), 0}), region);
+				auto const horizontal = inRegion(location.move({0, diagonal.x()}), region);
+				if ((!vertical && !horizontal) || (vertical && horizontal && !inRegion(location.move(diagonal), region)))
+					++sides[region];
 			}
 		}
-
-		return sidesCount * region.size();
-	}
-
-	long long getTotalDiscountedFencingPrice()
-	{
-		auto price = 0ll;
-		for (auto const& region : regions)
-			price += getDiscountedFencingPriceForRegion(region);
-		return price;
+		return getPrice(sides);
 	}
 
 	void drawIds() const
 	{
 		std::cout << "\n\n";
-		for (auto& line : data)
+		for (auto const y : range(yMax()))
 		{
-			for (auto& coordinate : line)
+			for (auto const x : range(xMax()))
 			{
-				std::cout << coordinate.strValue << coordinate.intValue << "\t";
+				std::cout << regions.label(y, x) << "\t";
 			}
 			std::cout << "\n";
 		}
 		std::cout << "\n\n";
 	}
 
-	std::vector<std::set<Location>> regions;
+	ComponentLabels regions;
 };
 
 
-class Twelve : public Puzzle
+class Twelve : public ParsedPuzzle<Farm>
 {
 public:
 	explicit Twelve()
-		: Puzzle(12)
+		: ParsedPuzzle(12)
 	{
 	}
 
-	long long partOne(const Input& input) override
+	// Square farm of about size plots. Plants come in blocks (set with the block parameter) with some strays.
+	static void generate(Generator& generator)
 	{
-		if (input.lines.empty())
-			return -1;
+		constexpr std::string_view plants = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+		auto const side = generator.side();
+		auto const blockSize = generator.getParameter("block", 8);
+		auto const blocksPerRow = side / blockSize + 1;
 
-		Farm farm{input.lines};
-		//farm.drawIds();
+		std::vector<char> blockPlants;
+		for ([[maybe_unused]] auto _ : range(blocksPerRow * blocksPerRow))
+			blockPlants.push_back(generator.pick(plants));
 
-		return farm.getTotalFencingPrice();
+		for (auto const y : range(side))
+		{
+			for (auto const x : range(side))
+			{
+				auto const block = (y / blockSize) * blocksPerRow + x / blockSize;
+				generator << (generator.chance(0.05) ? generator.pick(plants) : blockPlants[block]);
+			}
+			generator << '\n';
+		}
 	}
 
-	long long partTwo(const Input& input) override
+	Farm parse(const Input& input) override
 	{
-		if (input.lines.empty())
-			return -1;
+		return Farm{input.lines};
+	}
 
-		Farm farm{input.lines};
+	long long partOne(Farm const& farm) override
+	{
+		//farm.drawIds();
 
+		return farm.getTotalFencingPrice();
+	}
 
+	long long partTwo(Farm const& farm) override
+	{
 		return farm.getTotalDiscountedFencingPrice();
 	}
 };
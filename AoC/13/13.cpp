@@ -0,0 +1,4 @@
+#include "13.h"
+#include "Registry.h"
+
+static Registration<13, Thirteen> const registration{__DATE__ " " __TIME__};
@@ -11,28 +11,33 @@ public:
 	static auto constexpr bTokens = 1;
 	static auto constexpr correction = 10000000000000ll;
 
-	Game(std::vector<std::string> const& input, bool withCorrection)
+	Game(std::vector<std::string_view> const& input)
 	{
 		dA = parse(input[0]);
 		dB = parse(input[1]);
 		prize = parse(input[2]);
-		if (withCorrection)
-		{
-			prize.first += correction;
-			prize.second += correction;
-		}
 	}
 
-	static int parsePart(const std::string& part)
+	Game(WideLocation const& dA, WideLocation const& dB, WideLocation const& prize) :
+		dA(dA),
+		dB(dB),
+		prize(prize)
+	{
+	}
+
+	Game corrected() const
 	{
-		return std::stoi(part.substr(2));
+		auto game = *this;
+		game.prize.first += correction;
+		game.prize.second += correction;
+		return game;
 	}
 
-	static Location parse(std::string line)
+	// "Button A: X+94, Y+34" or "Prize: X=8400, Y=5400"
+	static WideLocation parse(std::string_view const line)
 	{
-		line = split(line, ": ")[1];
-		auto const parts = split(line, ", ");
-		return Location{parsePart(parts[1]), parsePart(parts[0])};
+		auto const [x, y] = scanNumbers<2>(line);
+		return WideLocation{y, x};
 	}
 
 	double distancePerTokenA() const
@@ -45,14 +50,14 @@ public:
 		return static_cast<double>(dB.getManhattenDistance({0, 0})) / bTokens;
 	}
 
-	Location play(long long a, long long b) const
+	WideLocation play(long long a, long long b) const
 	{
 		auto const dy = a * dA.y() + b * dB.y();
 		auto const dx = a * dA.x() + b * dB.x();
-		return Location{dy, dx};
+		return WideLocation{dy, dx};
 	}
 
-	long long findMaxPushes(Location& location, const Location& d) const
+	long long findMaxPushes(WideLocation& location, const WideLocation& d) const
 	{
 		auto const dx = std::abs(location.x() - prize.x());
 		auto const dy = std::abs(location.y() - prize.y());
@@ -60,17 +65,17 @@ public:
 		auto const maxPushesX = dx / d.x();
 		auto const maxPushesY = dy / d.y();
 
-		auto const maxPushes = min(maxPushesX, maxPushesY);
+		auto const maxPushes = (std::min)(maxPushesX, maxPushesY);
 		auto const dxMax = maxPushes * d.x();
 		auto const dyMax = maxPushes * d.y();
 		location = location.move({dyMax, dxMax});
 		return maxPushes;
 	}
 
-	void iterate(Location const& largerD, long long& largerNumPushes, Location const& smallerD,
+	void iterate(WideLocation const& largerD, long long& largerNumPushes, WideLocation const& smallerD,
 	             long long& smallerNumPushes) const
 	{
-		Location location{0, 0};
+		WideLocation location{0, 0};
 		largerNumPushes = findMaxPushes(location, largerD);
 		while (location != prize && largerNumPushes >= 0)
 		{
@@ -95,7 +100,7 @@ public:
 		else
 			iterate(dB, numPushesB, dA, numPushesA);
 
-		std::cout << std::format("\ngame finished! {} {}", numPushesA, numPushesB);
+		log<Verbosity::Trace>("\ngame finished! {} {}", numPushesA, numPushesB);
 
 		if (numPushesA < 0 || numPushesB < 0)
 			return 0; // no solution
@@ -112,16 +117,16 @@ public:
 		auto numPushesB = 0ll;
 		auto numPushesA = 0ll;
 
-		Location location{0, 0};
+		WideLocation location{0, 0};
 		auto const aDirection = location.getDirection(dA);
 		auto const bDirection = location.getDirection(dB);
 
 		while (location.x() < prize.x() && location.y() < prize.y())
 		{
 			auto const distance = prize.getManhattenDistance(location);
-			auto move = [&](Location const& d, long long& pushes)
+			auto move = [&](WideLocation const& d, long long& pushes)
 			{
-				auto const multiplier = max(1ll, (distance / d.getManhattenDistance({0, 0})) / 10);
+				auto const multiplier = (std::max)(1ll, (distance / d.getManhattenDistance({0, 0})) / 10);
 				location = location.move(d, multiplier);
 				pushes += multiplier;
 			};
@@ -139,30 +144,30 @@ public:
 
 		if (location != prize)
 		{
-			std::cout << std::format("\nNo prize! {} {}\n", numPushesA, numPushesB);
+			log<Verbosity::Trace>("\nNo prize! {} {}\n", numPushesA, numPushesB);
 			return 0; // No prize!! :(
 		}
 
-		std::cout << std::format("\nWin! {} {}\n", numPushesA, numPushesB);
+		log<Verbosity::Trace>("\nWin! {} {}\n", numPushesA, numPushesB);
 		return 3 * numPushesA + numPushesB;
 	}
 
-	Location dA;
-	Location dB;
-	Location prize;
+	WideLocation dA;
+	WideLocation dB;
+	WideLocation prize;
 };
 
 class Games
 {
 public:
-	Games(const Input& input, bool withCorrection)
+	Games(const Input& input)
 	{
-		std::vector<std::string> buffer;
+		std::vector<std::string_view> buffer;
 		for (auto const i : range(input.lines.size()))
 		{
 			if (i > 0 && (i + 1) % 4 == 0)
 			{
-				list.emplace_back(buffer, withCorrection);
+				list.emplace_back(buffer);
 				buffer.clear();
 			}
 			else
@@ -170,15 +175,15 @@ public:
 				buffer.push_back(input.lines[i]);
 			}
 		}
-		list.emplace_back(buffer, withCorrection);
+		list.emplace_back(buffer);
 	}
 
-	long long play() const
+	long long play(bool const withCorrection) const
 	{
 		auto count = 0ll;
 		for (auto const& game : list)
 		{
-			count += game.playSmart();
+			count += withCorrection ? game.corrected().playSmart() : game.playSmart();
 		}
 		return count;
 	}
@@ -186,29 +191,89 @@ public:
 	std::vector<Game> list;
 };
 
-class Thirteen : public Puzzle
+// Plays every game as soon as its three lines are in
+class ThirteenAccumulator : public Accumulator
+{
+public:
+	void add(std::string_view const line) override
+	{
+		if (line.empty())
+			return;
+
+		parts.push_back(Game::parse(line));
+		if (parts.size() < 3)
+			return;
+
+		Game const game{parts[0], parts[1], parts[2]};
+		tokens += game.playSmart();
+		correctedTokens += game.corrected().playSmart();
+		parts.clear();
+	}
+
+	std::optional<long long> partOne() const override
+	{
+		return tokens;
+	}
+
+	std::optional<long long> partTwo() const override
+	{
+		return correctedTokens;
+	}
+
+private:
+	std::vector<WideLocation> parts; // button A, button B and prize of the game being read
+	long long tokens{0};
+	long long correctedTokens{0};
+};
+
+class Thirteen : public ParsedPuzzle<Games>
 {
 public:
 	explicit Thirteen()
-		: Puzzle(13)
+		: ParsedPuzzle(13)
 	{
 	}
 
-	long long partOne(const Input& input) override
+	// size claw machines, about half of them winnable
+	static void generate(Generator& generator)
+	{
+		for (auto const index : range(generator.size()))
+		{
+			auto const aX = generator.number(10, 99), aY = generator.number(10, 99);
+			auto const bX = generator.number(10, 99), bY = generator.number(10, 99);
+			auto prizeX = generator.number(1000, 20000), prizeY = generator.number(1000, 20000);
+			if (generator.chance(0.5))
+			{
+				auto const a = generator.number(1, 100), b = generator.number(1, 100);
+				prizeX = a * aX + b * bX;
+				prizeY = a * aY + b * bY;
+			}
+
+			if (index > 0)
+				generator << '\n';
+			generator << "Button A: X+" << aX << ", Y+" << aY << '\n';
+			generator << "Button B: X+" << bX << ", Y+" << bY << '\n';
+			generator << "Prize: X=" << prizeX << ", Y=" << prizeY << '\n';
+		}
+	}
+
+	std::unique_ptr<Accumulator> createAccumulator() const
 	{
-		if (input.lines.empty())
-			return -1;
+		return std::make_unique<ThirteenAccumulator>();
+	}
 
-		auto games = Games{input, false};
-		return games.play();
+	Games parse(const Input& input) override
+	{
+		return Games{input};
 	}
 
-	long long partTwo(const Input& input) override
+	long long partOne(Games const& games) override
 	{
-		if (input.lines.empty())
-			return -1;
+		return games.play(false);
+	}
 
-		auto games = Games{input, true};
-		return games.play();
+	long long partTwo(Games const& games) override
+	{
+		return games.play(true);
 	}
 };
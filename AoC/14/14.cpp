@@ -0,0 +1,4 @@
+#include "14.h"
+#include "Registry.h"
+
+static Registration<14, Fourteen> const registration{__DATE__ " " __TIME__};
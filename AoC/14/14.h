@@ -4,13 +4,11 @@
 class Robot
 {
 public:
-	Robot(std::string const& input)
+	Robot(std::string_view const input)
 	{
-		auto const parts = split(input, " ");
-		auto const locationParts = split(parts[0].substr(2), ",");
-		location = {stoll(locationParts[1]), stoll(locationParts[0])};
-		auto const velocityParts = split(parts[1].substr(2), ",");
-		velocity = {stoll(velocityParts[1]), stoll(velocityParts[0])};
+		auto const [x, y, dx, dy] = scanNumbers<4>(input);
+		location = {y, x};
+		velocity = {dy, dx};
 	}
 
 	Location location;
@@ -21,18 +19,10 @@ public:
 class BathroomSecurity
 {
 public:
-	BathroomSecurity(const Input& input, int width, int height)
-		: grid(createInput(width, height), false)
+	BathroomSecurity(std::vector<Robot> const& robots, int width, int height)
+		: robots(robots),
+		  grid(height, width, '.')
 	{
-		for (auto const& line : input.lines)
-			robots.emplace_back(line);
-	}
-
-	static std::vector<std::string> createInput(int width, int height)
-	{
-		std::string str;
-		str.resize(width, '.');
-		return std::vector(height, str);
 	}
 
 	void moveRobot(Robot& robot) const
@@ -58,7 +48,7 @@ public:
 
 	void moveRobots(long long seconds)
 	{
-		for (auto _ : range(seconds))
+		for ([[maybe_unused]] auto _ : range(seconds))
 			moveRobots();
 	}
 
@@ -68,11 +58,11 @@ public:
 		auto robotGrid = grid;
 		for (auto const& robot : robots)
 		{
-			auto& coordinate = robotGrid.get(robot.location);
-			if (coordinate.intValue == -1)
-				coordinate.intValue = 1;
-			else
-				++coordinate.intValue;
+			auto& cell = robotGrid.get(robot.location);
+			if (cell == '.')
+				cell = '1';
+			else if (cell < '9')
+				++cell; // 9 stands for 9 or more
 		}
 		robotGrid.draw();
 	}
@@ -111,25 +101,17 @@ public:
 		return safetyScore;
 	}
 
-	bool hasAdjacentRobot(Robot const& robot) const
-	{
-		for (auto const& other : robots)
-		{
-			if (robot.location == other.location)
-				continue;
-
-			if (robot.location.getManhattenDistance(other.location) == 1)
-				return true;
-		}
-		return false;
-	}
-
 	bool maybeTree() const
 	{
+		BitGrid occupied{grid.yMax(), grid.xMax()};
+		for (auto const& robot : robots)
+			occupied.set(robot.location);
+		auto const nextToRobot = occupied.neighbours();
+
 		auto const numRobots = robots.size();
 		auto numAdjacentRobots = 0;
 		for (auto const& robot : robots)
-			if (hasAdjacentRobot(robot))
+			if (nextToRobot.test(robot.location))
 				++numAdjacentRobots;
 
 		return (2 * numAdjacentRobots) > numRobots;
@@ -140,49 +122,127 @@ public:
 };
 
 
-class Fourteen : public Puzzle
+// Part one only needs where each robot ends up after 100 seconds, which can be calculated directly. Part two looks at
+// all robots together and can't be streamed.
+class FourteenAccumulator : public Accumulator
 {
 public:
-	explicit Fourteen()
-		: Puzzle(14)
+	FourteenAccumulator(long long const width, long long const height) :
+		width(width),
+		height(height)
+	{
+	}
+
+	void add(std::string_view const line) override
+	{
+		Robot const robot{line};
+		auto const wrap = [](long long const value, long long const size) { return (value % size + size) % size; };
+		auto const x = wrap(robot.location.x() + 100 * robot.velocity.x(), width);
+		auto const y = wrap(robot.location.y() + 100 * robot.velocity.y(), height);
+
+		auto const xMiddle = width / 2;
+		auto const yMiddle = height / 2;
+		if (x == xMiddle || y == yMiddle)
+			return;
+		++quadrants[(x > xMiddle ? 1 : 0) + (y > yMiddle ? 2 : 0)];
+	}
+
+	std::optional<long long> partOne() const override
+	{
+		return quadrants[0] * quadrants[1] * quadrants[2] * quadrants[3];
+	}
+
+	std::optional<long long> partTwo() const override
 	{
+		return std::nullopt;
 	}
 
-	long long partOne(const Input& input) override
+private:
+	long long const width;
+	long long const height;
+	std::array<long long, 4> quadrants{};
+};
+
+class Fourteen : public ParsedPuzzle<std::vector<Robot>>
+{
+public:
+	explicit Fourteen()
+		: ParsedPuzzle(14)
 	{
-		if (input.lines.empty())
-			return -1;
+	}
 
-		if (input.lines.size() < 100)
+	// size robots in a room of width x height (parameters, 101 x 103 by default). Robots move less than a room per second.
+	static void generate(Generator& generator)
+	{
+		auto const width = generator.getParameter("width", 101);
+		auto const height = generator.getParameter("height", 103);
+		for ([[maybe_unused]] auto _ : range(generator.size()))
 		{
-			auto smallVariant = BathroomSecurity{input, 11, 7};
-			smallVariant.drawRobots();
-			smallVariant.moveRobots(100);
-			smallVariant.drawRobots();
-			return smallVariant.safetyFactor();
+			generator << "p=" << generator.number(0, width - 1) << ',' << generator.number(0, height - 1);
+			generator << " v=" << generator.number(1 - width, width - 1) << ',' << generator.number(1 - height, height - 1);
+			generator << '\n';
 		}
+	}
+
+	// A stream can't be recognised as the sample, so the room is the real size unless given
+	std::unique_ptr<Accumulator> createAccumulator() const
+	{
+		return std::make_unique<FourteenAccumulator>(getParameter("width", 101), getParameter("height", 103));
+	}
 
-		auto bathroomSecurity = BathroomSecurity{input, 101, 103};
+	std::vector<Robot> parse(const Input& input) override
+	{
+		std::vector<Robot> robots;
+		for (auto const& line : input.lines)
+			robots.emplace_back(line);
+		return robots;
+	}
+
+	long long partOne(std::vector<Robot> const& robots) override
+	{
+		auto bathroomSecurity = createBathroomSecurity(robots);
+		if (isSample(robots))
+			render([&] { bathroomSecurity.drawRobots(); });
 		bathroomSecurity.moveRobots(100);
+		if (isSample(robots))
+			render([&] { bathroomSecurity.drawRobots(); });
 		return bathroomSecurity.safetyFactor();
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(std::vector<Robot> const& robots) override
 	{
-		if (input.lines.size() < 100)
+		if (isSample(robots))
 			return -1; // Part two doesn't work on sample input
 
-		auto bathroomSecurity = BathroomSecurity{input, 101, 103};
+		auto bathroomSecurity = createBathroomSecurity(robots);
+		auto const width = getParameter("width", 101);
+		auto const height = getParameter("height", 103);
 		int seconds = 0;
 		while (!bathroomSecurity.maybeTree())
 		{
-			++seconds;
-			std::cout << seconds << "\n";
+			// The robots are back where they started after width * height seconds, random input may have no tree
+			if (++seconds == width * height)
+				return -1;
+			log<Verbosity::Trace>("{}\n", seconds);
 			bathroomSecurity.moveRobots();
 		}
 
-		bathroomSecurity.drawRobots();
+		render([&] { bathroomSecurity.drawRobots(); });
 
 		return seconds;
 	}
+
+private:
+	static bool isSample(std::vector<Robot> const& robots)
+	{
+		return robots.size() < 100;
+	}
+
+	// The room size can't be derived from the robots, it defaults to the sample or real size
+	BathroomSecurity createBathroomSecurity(std::vector<Robot> const& robots) const
+	{
+		auto const width = getParameter("width", isSample(robots) ? 11 : 101);
+		auto const height = getParameter("height", isSample(robots) ? 7 : 103);
+		return BathroomSecurity{robots, static_cast<int>(width), static_cast<int>(height)};
+	}
 };
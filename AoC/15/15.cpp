@@ -0,0 +1,4 @@
+#include "15.h"
+#include "Registry.h"
+
+static Registration<15, Fifteen> const registration{__DATE__ " " __TIME__};
@@ -4,11 +4,11 @@
 class Warehouse : public Grid
 {
 public:
-	static auto constexpr WallStr = "#";
-	static auto constexpr SmallBoxStr = "O";
-	static auto constexpr LeftBoxStr = "[";
-	static auto constexpr EmptyStr = ".";
-	static auto constexpr RobotStr = "@";
+	static char constexpr Wall = '#';
+	static char constexpr SmallBox = 'O';
+	static char constexpr LeftBox = '[';
+	static char constexpr Empty = '.';
+	static char constexpr RobotCell = '@';
 
 	Warehouse(const Input& input) : Grid(getGridInput(input), false)
 	{
@@ -20,13 +20,13 @@ public:
 	{
 		switch (ch)
 		{
-		case WallStr[0]:
+		case Wall:
 			return "##";
-		case SmallBoxStr[0]:
+		case SmallBox:
 			return "[]";
-		case EmptyStr[0]:
+		case Empty:
 			return "..";
-		case RobotStr[0]:
+		case RobotCell:
 			return "@.";
 		}
 		return {ch};
@@ -34,20 +34,19 @@ public:
 
 	static Input expandInput(Input const& input)
 	{
-		Input expanded{input};
-		expanded.lines.clear();
+		std::vector<std::string> expanded;
 		for (auto const& line : input.lines)
 		{
-			auto& expanedLine = expanded.lines.emplace_back();
+			auto& expanedLine = expanded.emplace_back();
 			for (auto const ch : line)
 				expanedLine += expandChar(ch);
 		}
-		return expanded;
+		return Input{expanded};
 	}
 
-	static std::vector<std::string> getGridInput(const Input& input)
+	static std::vector<std::string_view> getGridInput(const Input& input)
 	{
-		std::vector<std::string> gridlines;
+		std::vector<std::string_view> gridlines;
 		for (auto const& line : input.lines)
 		{
 			if (line.size() < 2)
@@ -78,7 +77,7 @@ public:
 	{
 		for (auto const& line : input.lines)
 		{
-			if (line.contains(WallStr[0]))
+			if (line.contains(Wall))
 				continue;
 
 			for (auto const ch : line)
@@ -89,26 +88,25 @@ public:
 
 	Location getRobot() const
 	{
-		for (auto const& line : data)
-			for (auto const& coordinate : line)
-				if (coordinate.strValue == RobotStr)
-					return coordinate.location;
+		for (auto const location : locations())
+			if (get(location) == RobotCell)
+				return location;
 		return {};
 	}
 
 	bool isWall(Location const& location)
 	{
-		return get(location).strValue == WallStr;
+		return get(location) == Wall;
 	}
 
 	bool isEmpty(Location const& location)
 	{
-		return get(location).strValue == EmptyStr;
+		return get(location) == Empty;
 	}
 
 	bool isSmallBox(Location const& location)
 	{
-		return get(location).strValue == SmallBoxStr;
+		return get(location) == SmallBox;
 	}
 
 	void moveBoxes(Location const& move, Location const& newRobotLocation)
@@ -123,33 +121,33 @@ public:
 				break; // free space behind the boxes, lets move them!
 		}
 
-		get(newRobotLocation).strValue = RobotStr;
-		get(location).strValue = SmallBoxStr;
-		get(robot).strValue = EmptyStr;
+		get(newRobotLocation) = RobotCell;
+		get(location) = SmallBox;
+		get(robot) = Empty;
 		robot = newRobotLocation;
 	}
 
 	Location getOtherBoxPart(Location const& boxPart)
 	{
-		return get(boxPart).strValue == LeftBoxStr ? boxPart.move({0, 1}) : boxPart.move({0, -1});
+		return get(boxPart) == LeftBox ? boxPart.move({0, 1}) : boxPart.move({0, -1});
 	}
 
-	void addLocation(std::map<Location, std::string>& map, Location const& location)
+	void addLocation(std::unordered_map<Location, char>& map, Location const& location)
 	{
-		map[location] = get(location).strValue;
+		map[location] = get(location);
 	}
 
 	void moveWideBoxes(Location const& move, Location const& newRobotLocation)
 	{
 		// newRobotLocation is also the location of the box that the robot is trying to push
 
-		std::map<Location, std::string> boxes;
+		std::unordered_map<Location, char> boxes;
 		addLocation(boxes, newRobotLocation);
 		addLocation(boxes, getOtherBoxPart(newRobotLocation));
 
 		while (true)
 		{
-			std::set<Location> adjacentBoxes;
+			std::unordered_set<Location> adjacentBoxes;
 			auto allAdjacentFound = true;
 			for (auto const& boxPartLocation : boxes | std::views::keys)
 			{
@@ -173,32 +171,32 @@ public:
 				break;
 		}
 		for (const auto& boxLocation : boxes | std::views::keys)
-			get(boxLocation).strValue = EmptyStr;
+			get(boxLocation) = Empty;
 
 		for (auto const& [boxLocation, boxValue] : boxes)
-			get(boxLocation.move(move)).strValue = boxValue;
+			get(boxLocation.move(move)) = boxValue;
 
-		get(newRobotLocation).strValue = RobotStr;
-		get(robot).strValue = EmptyStr;
+		get(newRobotLocation) = RobotCell;
+		get(robot) = Empty;
 		robot = newRobotLocation;
 	}
 
 	void moveRobot(Location const& move)
 	{
 		auto const newRobotLocation = robot.move(move);
-		auto& newRobotLocationValue = get(newRobotLocation).strValue;
-		if (newRobotLocationValue == WallStr)
+		auto& newRobotLocationValue = get(newRobotLocation);
+		if (newRobotLocationValue == Wall)
 			return;
 
-		if (newRobotLocationValue == EmptyStr)
+		if (newRobotLocationValue == Empty)
 		{
-			newRobotLocationValue = RobotStr;
-			get(robot).strValue = EmptyStr;
+			newRobotLocationValue = RobotCell;
+			get(robot) = Empty;
 			robot = newRobotLocation;
 			return;
 		}
 
-		if (newRobotLocationValue == SmallBoxStr)
+		if (newRobotLocationValue == SmallBox)
 			return moveBoxes(move, newRobotLocation);
 
 		moveWideBoxes(move, newRobotLocation);
@@ -209,7 +207,7 @@ public:
 		for (auto const& move : robotMoves)
 		{
 			moveRobot(move);
-			draw();
+			render([this] { draw(); });
 		}
 	}
 
@@ -221,10 +219,9 @@ public:
 	long long sumBoxesGPS() const
 	{
 		auto sum = 0ll;
-		for (auto const& line : data)
-			for (auto const& coordinate : line)
-				if (coordinate.strValue == SmallBoxStr || coordinate.strValue == LeftBoxStr)
-					sum += getGPS(coordinate.location);
+		for (auto const location : locations())
+			if (get(location) == SmallBox || get(location) == LeftBox)
+				sum += getGPS(location);
 		return sum;
 	}
 
@@ -232,33 +229,68 @@ public:
 	std::vector<Location> robotMoves;
 };
 
-class Fifteen : public Puzzle
+struct FifteenData
+{
+	Warehouse warehouse;
+	Warehouse wideWarehouse;
+};
+
+class Fifteen : public ParsedPuzzle<FifteenData>
 {
 public:
 	explicit Fifteen()
-		: Puzzle(15)
+		: ParsedPuzzle(15)
+	{
+	}
+
+	// Square warehouse of about size cells, followed by size moves (or the moves parameter)
+	static void generate(Generator& generator)
 	{
+		auto const side = (std::max)(generator.side(), 3ll);
+		for (auto const y : range(side))
+		{
+			for (auto const x : range(side))
+			{
+				if (y == 0 || x == 0 || y == side - 1 || x == side - 1)
+					generator << '#';
+				else if (y == side / 2 && x == side / 2)
+					generator << '@';
+				else if (generator.chance(0.1))
+					generator << '#';
+				else
+					generator << (generator.chance(0.3) ? 'O' : '.');
+			}
+			generator << '\n';
+		}
+		generator << '\n';
+
+		auto const numMoves = generator.getParameter("moves", generator.size());
+		for (auto const index : range(numMoves))
+		{
+			generator << generator.pick("<>^v");
+			if (index % 1000 == 999 || index + 1 == numMoves)
+				generator << '\n';
+		}
 	}
 
-	long long partOne(const Input& input) override
+	FifteenData parse(const Input& input) override
 	{
-		if (input.lines.empty())
-			return -1;
+		return {Warehouse{input}, Warehouse{Warehouse::expandInput(input)}};
+	}
 
-		auto warehouse = Warehouse{input};
+	long long partOne(FifteenData const& data) override
+	{
+		auto warehouse = data.warehouse;
 		warehouse.moveRobot();
-		warehouse.draw();
+		render([&] { warehouse.draw(); });
 		return warehouse.sumBoxesGPS();
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(FifteenData const& data) override
 	{
-		if (input.lines.empty())
-			return -1;
-
-		auto warehouse = Warehouse{Warehouse::expandInput(input)};
+		auto warehouse = data.wideWarehouse;
 		warehouse.moveRobot();
-		warehouse.draw();
+		render([&] { warehouse.draw(); });
 		return warehouse.sumBoxesGPS();
 	}
 };
@@ -0,0 +1,4 @@
+#include "16.h"
+#include "Registry.h"
+
+static Registration<16, Sixteen> const registration{__DATE__ " " __TIME__};
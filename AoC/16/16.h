@@ -1,197 +1,142 @@
 #pragma once
 #include "Input.h"
 
-struct Route
-{
-	Route(Location const& location, Location const& move) :
-		current(location),
-		direction(move)
-	{
-		seen[location] = points;
-	}
-
-	Route() = default;
-
-	void add(Location const& location, Location const& move)
-	{
-		if (move != direction)
-			points += 1000ll;
-		++points;
-		seen[location] = points;
-		direction = move;
-		current = location;
-	}
-
-	long long points{0};
-	Location current;
-	Location direction;
-	std::map<Location, long long> seen;
-	bool finished{false};
-};
-
+// A reindeer walks the maze facing a direction. A step forward costs a point, turning costs another 1000.
 class ReindeerMaze : public GridMap
 {
 public:
 	ReindeerMaze(const Input& input) :
-		GridMap(input.lines, false),
-		idCursor(0),
-		bestId(LLONG_MAX)
+		GridMap(input.lines, false, '#'),
+		states{static_cast<int>(xMax() + 1), static_cast<int>(yMax() + 1), static_cast<int>(orthogonalMoves.size())}
 	{
-		for (auto const& coordinate : map | std::views::values)
-		{
-			if (coordinate.strValue == "S")
-				start = coordinate.location;
-			if (coordinate.strValue == "E")
-				end = coordinate.location;
-		}
-		routes[idCursor++] = Route{start, {0, 1}};
+		start = find('S').value();
+		end = find('E').value();
 	}
 
-	void addRoutes(Route const& route)
+	// A state is a cell with the index in orthogonalMoves of the direction the reindeer faces there
+	void forEachStep(int const state, auto&& step) const
 	{
-		if (route.finished)
-		{
-			routes[idCursor++] = route;
-			return;
-		}
-
-		for (auto const& move : getMoves())
+		auto const location = states.location(state);
+		auto const direction = states.layer(state);
+		for (auto const move : range(orthogonalMoves.size()))
 		{
-			if (!boundsCheck(route.current, move))
+			auto const next = location.move(orthogonalMoves[move]);
+			if (at(next) == '#') // the border is a wall too
 				continue;
 
-			auto const& surroundingLocation = route.current.move(move);
-			if (map.at(surroundingLocation).strValue == "#" || route.seen.contains(surroundingLocation))
-				continue;
-
-			auto& newRoute = routes[idCursor++];
-			newRoute = route;
-			newRoute.add(surroundingLocation, move);
-			if (surroundingLocation == end)
-				newRoute.finished = true;
-
+			nodesExpanded.add();
+			step(states.id(next, move), move == direction ? 1 : 1001);
 		}
 	}
 
-	bool isBetterRoute(Route const& route) const
+	// Finds the lowest score and every tile on a route with that score
+	void findBestRoutes()
 	{
-		if (!locationToDirectionToHighscore.contains(route.current))
-			return true;
-		if (!locationToDirectionToHighscore.at(route.current).contains(route.direction))
-			return true;
-		return locationToDirectionToHighscore.at(route.current).at(route.direction) >= route.points;
+		ScopedTimer const timer{"maze findBestRoutes"};
+		GraphSearch search{states.size(), true};
+		auto const east = static_cast<int>(std::ranges::find(orthogonalMoves, Location{0, 1}) - orthogonalMoves.begin());
+		int const startState[] = {states.id(start, east)};
+		auto const steps = [this](int const state, auto&& step) { forEachStep(state, step); };
+		auto const isEnd = [this](int const state) { return states.location(state) == end; };
+		bestScore = search.dijkstra(startState, steps, isEnd);
+
+		std::vector<int> endStates;
+		for (auto const direction : range(orthogonalMoves.size()))
+			if (search.distance(states.id(end, direction)) == bestScore)
+				endStates.push_back(states.id(end, direction));
+
+		std::unordered_set<Location> tiles;
+		for (auto const state : search.statesOnShortestPaths(endStates))
+			tiles.insert(states.location(state));
+		bestTiles.assign(tiles.begin(), tiles.end());
 	}
 
-	void expandRoutes()
+	void drawBestTiles() const
 	{
-		while (true)
-		{
-			std::set<long long> toDelete;
-			long long highscore = LLONG_MAX;
-			auto const routesCopy = routes;
-			for (auto& [id, route] : routesCopy)
-			{
-				toDelete.insert(id); // We insert new routes so the old can be removed
-				addRoutes(route);
-			}
-
-			//for (auto const& newRoute : toInsert)
-			//	routes[idCursor++] = newRoute;
-
-			for (auto const& [id, route] : routes)
-			{
-				if (isBetterRoute(route))
-					locationToDirectionToHighscore[route.current][route.direction] = route.points;
-				else
-					toDelete.insert(id);
-
-				if (route.finished)
-				{
-					if (route.points > highscore)
-						toDelete.insert(id);
-					else
-						highscore = route.points;
-				}
-			}
-
-			for (auto const& id : toDelete)
-				routes.erase(id);
+		auto modified = *this;
+		for (auto const& tile : bestTiles)
+			modified.set(tile, 'O');
+		modified.draw();
+	}
 
-			//std::cout << routes.size() << "\n";
+	GridStates states;
+	Location end;
+	Location start;
+	long long bestScore{GraphSearch::unreachable};
+	std::vector<Location> bestTiles;
 
-			if (std::ranges::all_of(routes | std::views::values, [](Route const& route) { return route.finished; }))
-				return;
-		}
-	}
+	static inline Instrumentation::Counter const nodesExpanded{"maze nodes expanded"};
+};
 
-	Route const& getBestRoute()
+class Sixteen : public ParsedPuzzle<ReindeerMaze>
+{
+public:
+	explicit Sixteen()
+		: ParsedPuzzle(16)
 	{
-		expandRoutes();
-		return routes.begin()->second;
 	}
 
-	void drawRoute(Route const& route) const
+	// Square maze of about size cells, carved with a depth first search and then opened up a bit so that there
+	// are several routes. Start is in the bottom left corner, end in the top right.
+	static void generate(Generator& generator)
 	{
-		std::cout << "\n";
-		for (auto const y : range(yMax() + 1))
+		auto const side = (std::max)(generator.side(), 5ll) | 1;
+		std::vector<std::string> maze(side, std::string(side, '#'));
+
+		std::vector<Location> stack{{side - 2, 1}};
+		maze[side - 2][1] = '.';
+		std::array<Location, 4> const moves{Location{-2, 0}, Location{2, 0}, Location{0, 2}, Location{0, -2}};
+		while (!stack.empty())
 		{
-			for (auto const x : range(xMax() + 1))
+			auto const current = stack.back();
+			std::vector<Location> options;
+			for (auto const& move : moves)
 			{
-				if (route.seen.contains({y, x}))
-					std::cout << "X";
-				else
-					std::cout << map.at({y, x}).strValue;
+				auto const next = current.move(move);
+				if (next.y() > 0 && next.y() < side - 1 && next.x() > 0 && next.x() < side - 1 &&
+					maze[next.y()][next.x()] == '#')
+					options.push_back(next);
 			}
-			std::cout << "\n";
-		}
-		std::cout << "\n";
-	}
 
-	Route combinedRoutes() const
-	{
-		Route combined;
-		for (auto const& route : routes | std::views::values)
-			combined.seen.insert_range(route.seen);
-		return combined;
-	}
+			if (options.empty())
+			{
+				stack.pop_back();
+				continue;
+			}
 
-	Location end;
-	Location start;
-	std::map<long long, Route> routes;
-	std::map<Location, std::map<Location, long long>> locationToDirectionToHighscore;
-	long long idCursor;
-	long long bestId;
-};
+			auto const next = generator.pick(options);
+			maze[(current.y() + next.y()) / 2][(current.x() + next.x()) / 2] = '.';
+			maze[next.y()][next.x()] = '.';
+			stack.push_back(next);
+		}
 
-class Sixteen : public Puzzle
-{
-public:
-	explicit Sixteen()
-		: Puzzle(16)
-	{
+		for (auto const y : range(1, side - 1))
+			for (auto const x : range(1, side - 1))
+				if ((y % 2 == 0) != (x % 2 == 0) && generator.chance(0.05))
+					maze[y][x] = '.';
+
+		maze[side - 2][1] = 'S';
+		maze[1][side - 2] = 'E';
+		for (auto const& line : maze)
+			generator << line << '\n';
 	}
 
-	long long partOne(const Input& input) override
+	// Both parts need every best route, so the search is part of parsing
+	ReindeerMaze parse(const Input& input) override
 	{
-		if (input.lines.empty())
-			return -1;
-
 		auto maze = ReindeerMaze{input};
-		auto const bestRoute = maze.getBestRoute();
-		//maze.drawRoute(bestRoute);
-		return bestRoute.points;
+		maze.findBestRoutes();
+		return maze;
 	}
 
-	long long partTwo(const Input& input) override
+	long long partOne(ReindeerMaze const& maze) override
 	{
-		if (input.lines.empty())
-			return -1;
-
-		auto maze = ReindeerMaze{input};
-		maze.expandRoutes();
-		//for (auto const& route : maze.routes | std::views::values)
-		//	maze.drawRoute(route);
+		return maze.bestScore;
+	}
 
-		return maze.combinedRoutes().seen.size();
+	long long partTwo(ReindeerMaze const& maze) override
+	{
+		render([&] { maze.drawBestTiles(); });
+		return maze.bestTiles.size();
 	}
 };
@@ -0,0 +1,4 @@
+#include "17.h"
+#include "Registry.h"
+
+static Registration<17, Seventeen> const registration{__DATE__ " " __TIME__};
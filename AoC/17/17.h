@@ -13,12 +13,10 @@ class Computer
 public:
 	Computer(Input const& input)
 	{
-		registerA = std::stoll(split(input.lines[0], "A: ")[1]);
-		registerB = std::stoll(split(input.lines[1], "B: ")[1]);
-		registerC = std::stoll(split(input.lines[2], "C: ")[1]);
-		auto const programStr = split(input.lines[4], ": ")[1];
-		for (std::string const& numStr : split(programStr, ","))
-			program.push_back(std::stoi(numStr));
+		registerA = NumberScanner{input.lines[0]}.get();
+		registerB = NumberScanner{input.lines[1]}.get();
+		registerC = NumberScanner{input.lines[2]}.get();
+		program = scanNumbers<int>(input.lines[4]);
 	}
 
 	long long combo(long long operand) const
@@ -74,7 +72,7 @@ public:
 			instructionPointer = operand - 2;
 	}
 
-	void bxc(long long operand)
+	void bxc(long long)
 	{
 		registerB = registerB ^ registerC;
 	}
@@ -122,12 +120,18 @@ public:
 	{
 		while (instructionPointer < program.size() && instructionPointer >= 0)
 		{
+			instructionsExecuted.add();
 			operate(program[instructionPointer], program[instructionPointer + 1]);
 			instructionPointer += 2;
 		}
-		for (auto const& value : output | std::views::take(output.size() - 1))
-			std::cout << value << ",";
-		std::cout << output.back() << "\n";
+	}
+
+	std::string outputString() const
+	{
+		std::string result;
+		for (auto const& value : output)
+			result += std::format("{}{}", result.empty() ? "" : ",", value);
+		return result;
 	}
 
 	long long findCopy()
@@ -170,33 +174,52 @@ public:
 	long long registerB;
 	long long registerC;
 	std::vector<int> output;
+
+	static inline Instrumentation::Counter const instructionsExecuted{"computer instructions executed"};
 };
 
 
-class Seventeen : public Puzzle
+class Seventeen : public ParsedPuzzle<Computer>
 {
 public:
 	explicit Seventeen()
-		: Puzzle(17)
+		: ParsedPuzzle(17)
 	{
 	}
 
-	long long partOne(const Input& input) override
+	// A program of the usual shape with register A set to a number of size octal digits (at most 20). Not every
+	// variant of the program can output itself, so part two may fail.
+	static void generate(Generator& generator)
 	{
-		if (input.lines.empty())
-			return -1;
+		auto const digits = std::clamp(generator.size(), 1ll, 20ll);
+		auto const low = static_cast<long long>(std::pow(8, digits - 1));
+		generator << "Register A: " << generator.number(low, 8 * low - 1) << '\n';
+		generator << "Register B: 0\nRegister C: 0\n\n";
+		generator << "Program: 2,4,1," << generator.number(1, 7) << ",7,5,1," << generator.number(1, 7);
+		generator << ",4," << generator.number(0, 7) << ",0,3,5,5,3,0\n";
+	}
 
-		auto computer = Computer{input};
+	Computer parse(const Input& input) override
+	{
+		return Computer{input};
+	}
+
+	long long partOne(Computer const& parsed) override
+	{
+		auto computer = parsed;
 		computer.executeProgram();
+		log<Verbosity::Answer>("{}\n", computer.outputString()); // The answer is the output, not a number
 		return -1;
 	}
 
-	long long partTwo(const Input& input) override
+	bool cacheable(int const part) const override
 	{
-		if (input.lines.empty())
-			return -1;
+		return part != 1;
+	}
 
-		auto computer = Computer{input};
+	long long partTwo(Computer const& parsed) override
+	{
+		auto computer = parsed;
 		return computer.findCopy();
 	}
 };
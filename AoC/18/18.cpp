@@ -0,0 +1,4 @@
+#include "18.h"
+#include "Registry.h"
+
+static Registration<18, Eighteen> const registration{__DATE__ " " __TIME__};
@@ -1,26 +1,12 @@
 #pragma once
 #include "Input.h"
 
-struct MemoryRoute
-{
-	void add(Location const& location)
-	{
-		assert(order.empty() || location.getManhattenDistance(order.back()) == 1);
-		seen.insert(location);
-		order.push_back(location);
-	}
-
-	std::set<Location> seen;
-	std::vector<Location> order;
-	bool finished{false};
-};
-
 class FallingMemory : public GridMap
 {
 public:
-	FallingMemory(Input const& input, int const yMax, int const xMax) :
-		GridMap(yMax, xMax, "."),
-		fallingBytes(parseFallingBytes(input)),
+	FallingMemory(std::vector<Location> const& fallingBytes, int const yMax, int const xMax) :
+		GridMap(yMax, xMax, '.', '#'),
+		fallingBytes(fallingBytes),
 		end({yMax - 1, xMax - 1})
 	{
 	}
@@ -30,9 +16,7 @@ public:
 		std::vector<Location> result;
 		for (auto const& line : input.lines)
 		{
-			auto const parts = split(line, ",");
-			auto const x = stoll(parts[0]);
-			auto const y = stoll(parts[1]);
+			auto const [x, y] = scanNumbers<2>(line);
 			result.emplace_back(y, x);
 		}
 		return result;
@@ -41,129 +25,153 @@ public:
 	void simulateFallingBytes(int const num)
 	{
 		for (auto const i : range(num))
-			map[fallingBytes[i]].strValue = "#";
-	}
-
-	void addMoveToRoute(MemoryRoute& route, Location const& move) const
-	{
-		route.add(route.order.back().move(move));
-		route.finished = route.order.back() == end;
+			set(fallingBytes[i], '#');
 	}
 
-	GuidMap<MemoryRoute> findShortestRoutes() const
+	// The locations from the top left to the bottom right corner on a shortest route, empty when the way is blocked
+	std::vector<Location> findShortestRoute(GraphSearch& search) const
 	{
-		auto const start = Location{0, 0};
-		GuidMap<MemoryRoute> routes;
-		std::map<Location, std::pair<GUID, long long>> bestRoutes;
-		auto& firstRoute = routes[newGuid()];
-		firstRoute.add(start);
-		while (!routes.empty())
+		ScopedTimer const timer{"memory findShortestRoute"};
+		GridStates const states{static_cast<int>(xMax() + 1), static_cast<int>(yMax() + 1)};
+		int const start[] = {states.id({0, 0})};
+		auto const endState = states.id(end);
+		auto const steps = [&](int const state, auto&& step)
 		{
-			std::vector<MemoryRoute> newRoutes;
-			GuidSet deadEnds;
-			for (auto& [id, route] : routes)
+			auto const location = states.location(state);
+			for (auto const& move : getMoves())
 			{
-				auto const routeCopy = route;
-				auto addAsNewRoute = false;
-				auto const& lastLocation = routeCopy.order.back();
-				for (auto const& move : getSurroundingLocations(lastLocation))
-				{
-					auto const newLocation = lastLocation.move(move);
-					if (route.finished || route.seen.contains(newLocation) || map.at(newLocation).strValue == "#")
-						continue;
-
-					addMoveToRoute(addAsNewRoute ? newRoutes.emplace_back(routeCopy) : route, move);
-					addAsNewRoute = true;
-				}
-				if (!addAsNewRoute && !route.finished)
-					deadEnds.insert(id);
-			}
-
-			for (auto const& id : deadEnds)
-				routes.erase(id);
-
-			for (auto const& route : newRoutes)
-				routes[newGuid()] = route;
+				auto const next = location.move(move);
+				if (at(next) == '#') // the border is a wall
+					continue;
 
-			GuidSet nonOptimalRoutes;
-			for (auto const& [id, route] : routes)
-			{
-				auto const& lastLocation = route.order.back();
-				if (!bestRoutes.contains(lastLocation) || bestRoutes[lastLocation].second > route.order.size())
-					bestRoutes[lastLocation] = {id, route.order.size()};
-				else if (bestRoutes[lastLocation].first != id)
-					nonOptimalRoutes.insert(id);
+				nodesExpanded.add();
+				step(states.id(next), 1);
 			}
+		};
+		auto const distanceToEnd = [&](int const state) { return states.location(state).getManhattenDistance(end); };
+		auto const isEnd = [&](int const state) { return state == endState; };
+		auto const cost = search.aStar(start, steps, distanceToEnd, isEnd);
+
+		std::vector<Location> route;
+		if (cost != GraphSearch::unreachable)
+			for (auto const state : search.path(endState))
+				route.push_back(states.location(state));
+		return route;
+	}
 
-			for (auto const& id : nonOptimalRoutes)
-				routes.erase(id);
-
-			if (std::ranges::all_of(routes | std::views::values, [](auto const& route) { return route.finished; }))
-				return routes;
-		}
-		return {};
+	GraphSearch createSearch() const
+	{
+		return GraphSearch{static_cast<int>((xMax() + 1) * (yMax() + 1))};
 	}
 
-	void drawRoute(MemoryRoute const& route)
+	void drawRoute(std::vector<Location> const& route)
 	{
 		auto modified = *this;
-		for (auto const& location : route.order)
-			modified.map.at(location).strValue = "O";
+		for (auto const& location : route)
+			modified.set(location, 'O');
 		modified.draw();
 	}
 
 	std::vector<Location> const fallingBytes;
 	Location const end;
+
+	static inline Instrumentation::Counter const nodesExpanded{"memory nodes expanded"};
+};
+
+struct EighteenData
+{
+	FallingMemory memory;
+	int numBytes;
 };
 
-class Eighteen : public Puzzle
+class Eighteen : public ParsedPuzzle<EighteenData>
 {
 public:
 	explicit Eighteen()
-		: Puzzle(18)
+		: ParsedPuzzle(18)
 	{
 	}
 
-	long long partOne(const Input& input) override
+	// size distinct bytes falling on a grid x grid memory space (parameter, big enough by default). The first two
+	// bytes land in the free corners, so the solver can tell the grid size from the largest coordinate.
+	static void generate(Generator& generator)
 	{
-		if (input.lines.empty())
-			return -1;
-
-		auto const gridSize = input.lines.size() < 100 ? 7 : 71;
-		auto const numBytes = input.lines.size() < 100 ? 12 : 1024;
+		auto const grid = generator.getParameter(
+			"grid", (std::max)(7ll, static_cast<long long>(std::ceil(std::sqrt(2.0 * generator.size())))));
+		auto const cells = grid * grid - 2; // start and end stay free
+		auto const numBytes = (std::min)(generator.size(), cells);
+
+		// Fisher-Yates shuffle that only remembers the cells it moved
+		std::unordered_map<long long, long long> moved;
+		auto const cellAt = [&](long long const index)
+		{
+			auto const it = moved.find(index);
+			return it == moved.end() ? index : it->second;
+		};
+		long long const corners[] = {grid - 1, grid * (grid - 1)}; // top right and bottom left
+		for (auto const index : range(numBytes))
+		{
+			auto const other = index < 2 ? corners[index] - 1 : generator.number(index, cells - 1);
+			auto const cell = cellAt(other) + 1;
+			moved[other] = cellAt(index);
+			generator << cell % grid << ',' << cell / grid << '\n';
+		}
+	}
 
-		auto fallingMemory = FallingMemory{input, gridSize, gridSize};
-		fallingMemory.simulateFallingBytes(numBytes);
-		fallingMemory.draw();
+	EighteenData parse(const Input& input) override
+	{
+		// The grid reaches the largest coordinate, which is 6 for the sample and 70 for the real input. The default
+		// number of bytes is the sample's or real one, never more than there are.
+		auto const fallingBytes = FallingMemory::parseFallingBytes(input);
+		long long largest = 0;
+		for (auto const& location : fallingBytes)
+			largest = (std::max)({largest, location.x(), location.y()});
+		auto const gridSize = static_cast<int>(getParameter("grid", largest + 1));
+		if (largest >= gridSize)
+			throw std::invalid_argument(std::format("a byte falls at coordinate {}, outside the {}x{} grid", largest, gridSize, gridSize));
+
+		auto const isSample = input.lines.size() < 100;
+		auto const numBytes = static_cast<int>(
+			(std::min)(getParameter("bytes", isSample ? 12 : 1024), static_cast<long long>(fallingBytes.size())));
+		return {FallingMemory{fallingBytes, gridSize, gridSize}, numBytes};
+	}
 
-		auto const shortestRoutes = fallingMemory.findShortestRoutes();
-		for (auto const& route : shortestRoutes | std::views::values)
-			fallingMemory.drawRoute(route);
-		return shortestRoutes.begin()->second.order.size() - 1;
+	long long partOne(EighteenData const& data) override
+	{
+		auto fallingMemory = data.memory;
+		fallingMemory.simulateFallingBytes(data.numBytes);
+		render([&] { fallingMemory.draw(); });
+
+		auto search = fallingMemory.createSearch();
+		auto const route = fallingMemory.findShortestRoute(search);
+		render([&] { fallingMemory.drawRoute(route); });
+		return static_cast<long long>(route.size()) - 1;
 	}
 
-	long long partTwo(const Input& input) override
+	bool cacheable(int const part) const override
 	{
-		if (input.lines.empty())
-			return -1;
+		return part != 2;
+	}
 
-		auto const gridSize = input.lines.size() < 100 ? 7 : 71;
-		auto fallingMemory = FallingMemory{input, gridSize, gridSize};
-		auto numBytes = input.lines.size() < 100 ? 12 : 1024;
+	long long partTwo(EighteenData const& data) override
+	{
+		auto fallingMemory = data.memory;
+		auto search = fallingMemory.createSearch();
+		auto numBytes = data.numBytes;
 		while (true)
 		{
+			// Generated inputs can leave the way open after every byte fell
+			if (numBytes == static_cast<int>(fallingMemory.fallingBytes.size()))
+				return -1;
 			++numBytes;
-			std::cout << "\nnumbytes: " << numBytes;
+			log<Verbosity::Trace>("\nnumbytes: {}", numBytes);
 			fallingMemory.simulateFallingBytes(numBytes);
-			// We could write another algorithm that stops when a route has been found
-			// instead of finding the absolut shortest one every time.
-			// But this still runs in a minute or so because it gets faster with each iteration.
-			if (fallingMemory.findShortestRoutes().empty())
+			if (fallingMemory.findShortestRoute(search).empty())
 				break;
 		}
 
 		auto const blockage = fallingMemory.fallingBytes[numBytes - 1];
-		std::cout << "\n" << blockage.x() << "," << blockage.y() << "\n";
+		log<Verbosity::Answer>("\n{},{}\n", blockage.x(), blockage.y()); // The answer is the coordinate
 
 		return numBytes;
 	}
@@ -0,0 +1,4 @@
+#include "2.h"
+#include "Registry.h"
+
+static Registration<2, Two> const registration{__DATE__ " " __TIME__};
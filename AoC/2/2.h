@@ -1,24 +1,47 @@
 #pragma once
 #include "Input.h"
 
-class Two : public Puzzle
+using Reports = std::vector<std::vector<int>>;
+
+class Two : public ParsedPuzzle<Reports>
 {
 public:
 	explicit Two()
-		: Puzzle(2)
+		: ParsedPuzzle(2)
 	{
 	}
 
-	static void parse(const Input& input, std::vector<std::vector<int>>& out)
+	// size reports, mostly steady with the occasional bad level
+	static void generate(Generator& generator)
 	{
-		for (auto const& line : input.lines)
+		for ([[maybe_unused]] auto _ : range(generator.size()))
 		{
-			auto& outLine = out.emplace_back();
-			for (auto const& numStr : split(line, " "))
-				outLine.push_back(std::stoi(numStr));
+			auto level = generator.number(30, 70);
+			auto const direction = generator.chance(0.5) ? 1 : -1;
+			auto const numLevels = generator.number(5, 8);
+			for (auto const index : range(numLevels))
+			{
+				generator << level << (index + 1 < numLevels ? ' ' : '\n');
+				level += direction * (generator.chance(0.1) ? generator.number(-1, 5) : generator.number(1, 3));
+			}
 		}
 	}
 
+	std::unique_ptr<Accumulator> createAccumulator() const;
+
+	static std::vector<int> parseReport(std::string_view const line)
+	{
+		return scanNumbers<int>(line);
+	}
+
+	Reports parse(const Input& input) override
+	{
+		Reports out;
+		for (auto const& line : input.lines)
+			out.push_back(parseReport(line));
+		return out;
+	}
+
 	static bool isSafe(std::vector<int> const& input)
 	{
 		std::optional<int> prev;
@@ -51,11 +74,8 @@ public:
 		return true;
 	}
 
-	long long partOne(const Input& input) override
+	long long partOne(Reports const& parsed) override
 	{
-		std::vector<std::vector<int>> parsed;
-		parse(input, parsed);
-
 		auto count = 0;
 		for (auto const& line : parsed)
 			if (isSafe(line))
@@ -80,11 +100,8 @@ public:
 		return false;
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(Reports const& parsed) override
 	{
-		std::vector<std::vector<int>> parsed;
-		parse(input, parsed);
-
 		auto count = 0;
 		for (auto const& line : parsed)
 			if (isModifiedSafe(line))
@@ -93,3 +110,36 @@ public:
 		return count;
 	}
 };
+
+// Reports are independent, so streaming just keeps both counts
+class TwoAccumulator : public Accumulator
+{
+public:
+	void add(std::string_view const line) override
+	{
+		auto const report = Two::parseReport(line);
+		if (Two::isSafe(report))
+			++safe;
+		if (Two::isModifiedSafe(report))
+			++modifiedSafe;
+	}
+
+	std::optional<long long> partOne() const override
+	{
+		return safe;
+	}
+
+	std::optional<long long> partTwo() const override
+	{
+		return modifiedSafe;
+	}
+
+private:
+	long long safe{0};
+	long long modifiedSafe{0};
+};
+
+inline std::unique_ptr<Accumulator> Two::createAccumulator() const
+{
+	return std::make_unique<TwoAccumulator>();
+}
@@ -0,0 +1,4 @@
+#include "3.h"
+#include "Registry.h"
+
+static Registration<3, Three> const registration{__DATE__ " " __TIME__};
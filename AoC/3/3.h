@@ -11,36 +11,51 @@ public:
 	{
 	}
 
-	long long partOne(const Input& input) override
+	// size bytes of corrupted memory in lines of 3000 bytes
+	static void generate(Generator& generator)
 	{
-		auto count = 0;
-		for (auto const& line : input.lines)
+		constexpr std::string_view noise = "mul(),don't%&*[]<>!@^ 0123456789;:'?#$+-{}/who()select()";
+		auto lineLength = 0ll;
+		for (auto written = 0ll; written < generator.size();)
 		{
-			const std::regex regex{R"(mul\(\d+,\d+\))"};
-			auto it = std::sregex_iterator{line.begin(), line.end(), regex};
-			for (; it != std::sregex_iterator(); ++it)
+			std::string token;
+			if (generator.chance(0.02))
+				token = std::format("mul({},{})", generator.number(1, 999), generator.number(1, 999));
+			else if (generator.chance(0.002))
+				token = generator.chance(0.5) ? "do()" : "don't()";
+			else
+				token = std::string{generator.pick(noise)};
+
+			generator << token;
+			written += static_cast<long long>(token.size());
+			lineLength += static_cast<long long>(token.size());
+			if (lineLength >= 3000)
 			{
-				auto const match = it->str();
-				bool commaFound = false;
-				std::string firstNumStr, secondNumStr;
-				for (auto const ch : match | std::views::drop(4))
-				{
-					if (ch == ',')
-					{
-						commaFound = true;
-						continue;
-					}
-					if (!std::isdigit(ch))
-						continue;
-					if (!commaFound)
-						firstNumStr += ch;
-					else
-						secondNumStr += ch;
-				}
-				//std::cout << std::format("\n{}: {} * {}\n", match, firstNumStr, secondNumStr);
-				count += (std::stoi(firstNumStr) * std::stoi(secondNumStr));
+				generator << '\n';
+				lineLength = 0;
 			}
 		}
+		generator << '\n';
+	}
+
+	static long long multiply(std::string_view const memory)
+	{
+		auto count = 0ll;
+		const std::regex regex{R"(mul\(\d+,\d+\))"};
+		using Iterator = std::regex_iterator<std::string_view::const_iterator>;
+		for (auto it = Iterator{memory.begin(), memory.end(), regex}; it != Iterator(); ++it)
+		{
+			auto const [first, second] = scanNumbers<2>(std::string_view{(*it)[0].first, (*it)[0].second});
+			count += first * second;
+		}
+		return count;
+	}
+
+	long long partOne(const Input& input) override
+	{
+		auto count = 0ll;
+		for (auto const& line : input.lines)
+			count += multiply(line);
 		return count;
 	}
 
@@ -49,10 +64,6 @@ public:
 		const std::string enableStr = "do()";
 		const std::string disableStr = "don't()";
 
-
-		auto modified = input;
-		modified.lines.clear();
-
 		std::string oneline;
 		for (auto const& line : input.lines)
 			oneline += line;
@@ -75,8 +86,6 @@ public:
 			oneline = first + second;
 		}
 
-		modified.lines.push_back(oneline);
-
-		return partOne(modified);
+		return multiply(oneline);
 	}
 };
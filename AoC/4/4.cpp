@@ -0,0 +1,4 @@
+#include "4.h"
+#include "Registry.h"
+
+static Registration<4, Four> const registration{__DATE__ " " __TIME__};
@@ -9,33 +9,44 @@ public:
 	{
 	}
 
-	static void draw(Grid const& grid, int const count)
+	// Square grid of about size letters
+	static void generate(Generator& generator)
+	{
+		auto const side = generator.side();
+		for ([[maybe_unused]] auto _ : range(side))
+		{
+			for ([[maybe_unused]] auto _ : range(side))
+				generator << generator.pick("XMAS");
+			generator << '\n';
+		}
+	}
+
+	static void draw(GridView const grid, int const count)
 	{
 		std::cout << "\n";
-		for (auto const& line : grid.data)
+		for (auto const y : range(grid.yMax()))
 		{
-			for (auto const& coordinate : line)
-			{
-				std::cout << coordinate.strValue;
-			}
+			for (auto const x : range(grid.xMax()))
+				std::cout << grid.get(y, x);
 			std::cout << "\n";
 		}
 		std::cout << count << " times XMAS found\n";
 	}
 
-	static int countHorizontal(Grid const& grid)
+	static int countHorizontal(GridView const grid)
 	{
 		int count = 0;
-		for (auto const& line : grid.data)
+		for (auto const y : range(grid.yMax()))
 		{
 			std::string xmas = "XMAS";
 			int xmasIndex = 0;
 			int const xmasEnd = xmas.size();
-			for (auto const& coordinate : line)
+			for (auto const x : range(grid.xMax()))
 			{
-				if (coordinate.strValue == std::string{xmas[xmasIndex]})
+				auto const ch = grid.get(y, x);
+				if (ch == xmas[xmasIndex])
 					++xmasIndex;
-				else if (coordinate.strValue == std::string{xmas[0]})
+				else if (ch == xmas[0])
 					xmasIndex = 1;
 				else
 					xmasIndex = 0;
@@ -51,7 +62,7 @@ public:
 		return count;
 	}
 
-	static int countDiagonal(Grid const& grid)
+	static int countDiagonal(GridView const grid)
 	{
 		int count = 0;
 		int const xMax = grid.xMax();
@@ -67,8 +78,7 @@ public:
 				int xCur = x, yCur = y;
 				while (yCur < yMax && xCur < xMax)
 				{
-					auto const& coordinate = grid.data[yCur][xCur];
-					if (coordinate.strValue == std::string{xmas[xmasIndex]})
+					if (grid.get(yCur, xCur) == xmas[xmasIndex])
 						++xmasIndex;
 					else
 						break;
@@ -89,28 +99,24 @@ public:
 		return count;
 	}
 
-	static bool isMas(Grid& grid, Coordinate const& coordinate, bool const flip)
+	static bool isMas(Grid const& grid, int const y, int const x, bool const flip)
 	{
 		auto const d = flip ? -1 : 1;
-		return coordinate.strValue == "M" && grid.get(coordinate, d, 1).strValue == "A" && grid.get(
-				coordinate, 2 * d, 2).
-			strValue == "S";
+		return grid.get(y, x) == 'M' && grid.get(y + d, x + 1) == 'A' && grid.get(y + 2 * d, x + 2) == 'S';
 	}
 
-	static bool isSam(Grid& grid, Coordinate const& coordinate, bool const flip)
+	static bool isSam(Grid const& grid, int const y, int const x, bool const flip)
 	{
 		auto const d = flip ? -1 : 1;
-		return coordinate.strValue == "S" && grid.get(coordinate, d, 1).strValue == "A" && grid.get(
-				coordinate, 2 * d, 2).
-			strValue == "M";
+		return grid.get(y, x) == 'S' && grid.get(y + d, x + 1) == 'A' && grid.get(y + 2 * d, x + 2) == 'M';
 	}
 
-	static bool isSamOrMas(Grid& grid, Coordinate const& coordinate, bool const flip)
+	static bool isSamOrMas(Grid const& grid, int const y, int const x, bool const flip)
 	{
-		return isMas(grid, coordinate, flip) || isSam(grid, coordinate, flip);
+		return isMas(grid, y, x, flip) || isSam(grid, y, x, flip);
 	}
 
-	static int countXMas(Grid& grid)
+	static int countXMas(Grid const& grid)
 	{
 		int count = 0;
 		int const xMax = grid.xMax();
@@ -120,9 +126,7 @@ public:
 		{
 			for (auto const x : range(xMax - 2))
 			{
-				auto const& first = grid.get(y, x);
-				auto const& second = grid.get(y + 2, x);
-				if (isSamOrMas(grid, first, false) && isSamOrMas(grid, second, true))
+				if (isSamOrMas(grid, y, x, false) && isSamOrMas(grid, y + 2, x, true))
 					++count;
 			}
 		}
@@ -134,11 +138,11 @@ public:
 	long long partOne(const Input& input) override
 	{
 		auto const grid = Grid{input.lines, false};
-		auto const horizontal = countHorizontal(grid);
+		auto const horizontal = countHorizontal(grid.view());
 		auto const horizontalMirrored = countHorizontal(grid.mirrorVertical());
 		auto const vertical = countHorizontal(grid.transpose());
 		auto const verticalMirrored = countHorizontal(grid.transpose().mirrorVertical());
-		auto const diagonal = countDiagonal(grid); // 1
+		auto const diagonal = countDiagonal(grid.view()); // 1
 		auto const diagonalMirroredVertical = countDiagonal(grid.mirrorVertical()); // 1
 		auto const diagonalMirroredHorizontal = countDiagonal(grid.mirrorHorizontal());
 		auto const diagonalMirroredHorizontalVertical = countDiagonal(grid.mirrorHorizontal().mirrorVertical());
@@ -149,7 +153,7 @@ public:
 
 	long long partTwo(const Input& input) override
 	{
-		auto grid = Grid{input.lines, false};
+		auto const grid = Grid{input.lines, false};
 		return countXMas(grid);
 	}
 };
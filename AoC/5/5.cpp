@@ -0,0 +1,4 @@
+#include "5.h"
+#include "Registry.h"
+
+static Registration<5, Five> const registration{__DATE__ " " __TIME__};
@@ -10,15 +10,50 @@ struct FiveData
 	std::vector<std::vector<int>> pagesList;
 };
 
-class Five : public Puzzle
+class Five : public ParsedPuzzle<FiveData>
 {
 public:
 	explicit Five()
-		: Puzzle(5)
+		: ParsedPuzzle(5)
 	{
 	}
 
-	FiveData parse(Input const& input)
+	// A full ordering of 49 pages followed by size updates, about half of them in the right order
+	static void generate(Generator& generator)
+	{
+		std::vector<int> pages;
+		for (auto const page : range(10, 100))
+			pages.push_back(page);
+		std::ranges::shuffle(pages, generator.random);
+		pages.resize(49);
+
+		std::vector<std::pair<int, int>> rules;
+		for (auto const first : range(pages.size()))
+			for (auto const second : range(first + 1, pages.size()))
+				rules.emplace_back(pages[first], pages[second]);
+		std::ranges::shuffle(rules, generator.random);
+		for (auto const& [before, after] : rules)
+			generator << before << '|' << after << '\n';
+		generator << '\n';
+
+		std::vector<int> order(100);
+		for (auto const index : range(pages.size()))
+			order[pages[index]] = index;
+
+		for ([[maybe_unused]] auto _ : range(generator.size()))
+		{
+			auto update = pages;
+			std::ranges::shuffle(update, generator.random);
+			update.resize(2 * generator.number(2, 11) + 1);
+			if (generator.chance(0.5))
+				std::ranges::sort(update, [&](int const first, int const second) { return order[first] < order[second]; });
+
+			for (auto const index : range(update.size()))
+				generator << update[index] << (index + 1 < static_cast<int>(update.size()) ? ',' : '\n');
+		}
+	}
+
+	FiveData parse(Input const& input) override
 	{
 		FiveData fiveData;
 
@@ -36,8 +71,8 @@ public:
 
 		for (auto const& line : first)
 		{
-			auto const parts = split(line, "|");
-			fiveData.ordering.insert(std::make_pair(std::stoi(parts[0]), std::stoi(parts[1])));
+			auto const [before, after] = scanNumbers<2, int>(line);
+			fiveData.ordering.insert(std::make_pair(before, after));
 		}
 
 		for (auto const& line : second)
@@ -45,10 +80,7 @@ public:
 			if (line.empty())
 				continue;
 
-			auto const parts = split(line, ",");
-			auto& lineData = fiveData.pagesList.emplace_back();
-			for (auto const& part : parts)
-				lineData.push_back(std::stoi(part));
+			fiveData.pagesList.push_back(scanNumbers<int>(line));
 		}
 
 		return fiveData;
@@ -69,10 +101,8 @@ public:
 		return valid;
 	}
 
-	long long partOne(const Input& input) override
+	long long partOne(FiveData const& parsed) override
 	{
-		auto const parsed = parse(input);
-
 		auto count = 0;
 		for (auto const& pages : parsed.pagesList)
 		{
@@ -86,9 +116,8 @@ public:
 		return count;
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(FiveData const& parsed) override
 	{
-		auto const parsed = parse(input);
 		auto count = 0;
 		for (auto const& pages : parsed.pagesList)
 		{
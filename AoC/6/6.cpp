@@ -0,0 +1,4 @@
+#include "6.h"
+#include "Registry.h"
+
+static Registration<6, Six> const registration{__DATE__ " " __TIME__};
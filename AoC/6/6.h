@@ -1,6 +1,5 @@
 #pragma once
 #include <execution>
-#include <map>
 
 #include "Input.h"
 
@@ -15,13 +14,13 @@ enum class Direction
 class Map : public Grid
 {
 public:
-	Map(std::vector<std::string> const& input, bool convertToInt)
+	Map(std::vector<std::string_view> const& input, bool convertToInt)
 		: Grid(input, convertToInt)
 	{
-		for (auto& line : data)
-			for (auto& coordinate : line)
-				if (coordinate.strValue == "^")
-					current = &coordinate;
+		for (auto const location : locations())
+			if (get(location) == '^')
+				current = location;
+		visited.fill(BitGrid{yMax(), xMax()});
 	}
 
 	static Direction turn(Direction direction)
@@ -40,29 +39,29 @@ public:
 		throw std::runtime_error("");
 	}
 
-	static std::string drawDirection(Direction direction)
+	static char drawDirection(Direction direction)
 	{
 		switch (direction)
 		{
 		case Direction::Up:
 		case Direction::Down:
-			return "|";
+			return '|';
 		case Direction::Left:
 		case Direction::Right:
-			return "-";
+			return '-';
 		}
 		throw std::runtime_error("");
 	}
 
-	Coordinate& step()
+	Location step() const
 	{
-		const auto [dy, dx] = getStep();
-		if (boundsCheck(*current, dy, dx))
-			return get(*current, dy, dx);
-		return *current;
+		auto const next = current.move(getStep());
+		if (boundsCheck(next))
+			return next;
+		return current;
 	}
 
-	std::pair<int, int> getStep() const
+	Location getStep() const
 	{
 		switch (direction)
 		{
@@ -83,29 +82,30 @@ public:
 	{
 		while (true)
 		{
-			if (visited[current->location].contains(direction))
+			auto& visitedInDirection = visited[static_cast<int>(direction)];
+			if (visitedInDirection.test(current))
 				return true; // loop
 
-			visited[current->location].insert(direction);
-			current->strValue = drawDirection(direction);
-			auto& next = step();
-			if (next.strValue == "#")
+			visitedInDirection.set(current);
+			get(current) = drawDirection(direction);
+			auto const next = step();
+			if (get(next) == '#')
 				direction = turn(direction);
-			else if (&next == current)
+			else if (next == current)
 				return false;
 			else
-				current = &next;
+				current = next;
 		}
 	}
 
 	int countVisited() const
 	{
-		return static_cast<int>(visited.size());
+		return static_cast<int>((visited[0] | visited[1] | visited[2] | visited[3]).count());
 	}
 
-	Coordinate* current;
+	Location current;
 	Direction direction{Direction::Up};
-	std::map<Location, std::set<Direction>> visited;
+	std::array<BitGrid, 4> visited; // by direction
 };
 
 
@@ -117,6 +117,23 @@ public:
 	{
 	}
 
+	// Square lab of about size cells with the guard in the middle
+	static void generate(Generator& generator)
+	{
+		auto const side = generator.side();
+		for (auto const y : range(side))
+		{
+			for (auto const x : range(side))
+			{
+				if (y == side / 2 && x == side / 2)
+					generator << '^';
+				else
+					generator << (generator.chance(0.05) ? '#' : '.');
+			}
+			generator << '\n';
+		}
+	}
+
 	long long partOne(const Input& input) override
 	{
 		Map map{input.lines, false};
@@ -130,16 +147,16 @@ public:
 	{
 		Map const map{input.lines, false};
 		std::atomic_int count = 0;
-		for (auto const& line : map.data)
+		for (auto const y : range(map.yMax()))
 		{
-			std::for_each(std::execution::par_unseq, line.begin(), line.end(), [&](Coordinate const& coordinate)
+			auto const row = map.row(y);
+			std::for_each(std::execution::par_unseq, row.begin(), row.end(), [&](char const& cell)
 			{
-				auto copy = map;
-				auto& editCoordinate = copy.get(coordinate.location);
-				if (editCoordinate.strValue == "#")
+				if (cell == '#')
 					return;
 
-				editCoordinate.strValue = "#";
+				auto copy = map;
+				copy.get(y, static_cast<int>(&cell - row.data())) = '#';
 				if (copy.walk())
 					++count;
 				//map.draw();
@@ -0,0 +1,4 @@
+#include "7.h"
+#include "Registry.h"
+
+static Registration<7, Seven> const registration{__DATE__ " " __TIME__};
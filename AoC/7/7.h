@@ -12,12 +12,12 @@ enum class Operator
 
 struct Calculation
 {
-	Calculation(std::string const& line)
+	Calculation(std::string_view const line)
 	{
-		const auto parts = split(line, ": ");
-		result = std::stoll(parts[0]);
-		for (auto const& num : split(parts[1], " "))
-			numbers.push_back(std::stoll(num));
+		NumberScanner scanner{line};
+		result = scanner.get();
+		while (auto const number = scanner.next())
+			numbers.push_back(*number);
 	}
 
 	static long long concat(long long first, long long second)
@@ -73,23 +73,87 @@ struct Calculation
 	std::vector<long long> numbers;
 };
 
-class Seven : public Puzzle
+// Equations are independent, so streaming only keeps the totals
+class SevenAccumulator : public Accumulator
+{
+public:
+	void add(std::string_view const line) override
+	{
+		Calculation const calculation{line};
+		if (calculation.valid())
+			validTotal += calculation.result;
+		if (calculation.validP2())
+			validP2Total += calculation.result;
+	}
+
+	std::optional<long long> partOne() const override
+	{
+		return validTotal;
+	}
+
+	std::optional<long long> partTwo() const override
+	{
+		return validP2Total;
+	}
+
+private:
+	long long validTotal{0};
+	long long validP2Total{0};
+};
+
+class Seven : public ParsedPuzzle<std::vector<Calculation>>
 {
 public:
 	explicit Seven()
-		: Puzzle(7)
+		: ParsedPuzzle(7)
+	{
+	}
+
+	// size equations, about half of them solvable
+	static void generate(Generator& generator)
 	{
+		constexpr auto limit = 1000000000000000ll;
+		for ([[maybe_unused]] auto _ : range(generator.size()))
+		{
+			std::vector<long long> numbers;
+			for ([[maybe_unused]] auto _ : range(generator.number(3, 8)))
+				numbers.push_back(generator.number(1, 99));
+
+			auto result = numbers[0];
+			for (auto const& number : numbers | std::views::drop(1))
+			{
+				auto const op = static_cast<Operator>(generator.number(0, 2));
+				auto const next = Calculation::operate(op, result, number);
+				result = next > limit ? result + number : next;
+			}
+			if (generator.chance(0.5))
+				result += generator.number(1, 9);
+
+			generator << result << ':';
+			for (auto const& number : numbers)
+				generator << ' ' << number;
+			generator << '\n';
+		}
 	}
 
-	long long partOne(const Input& input) override
+	std::unique_ptr<Accumulator> createAccumulator() const
 	{
-		if (input.lines.empty())
-			return -1;
+		return std::make_unique<SevenAccumulator>();
+	}
 
-		auto count = 0ll;
+	std::vector<Calculation> parse(const Input& input) override
+	{
+		std::vector<Calculation> calculations;
 		for (auto const& line : input.lines)
+			calculations.emplace_back(line);
+		return calculations;
+	}
+
+	long long partOne(std::vector<Calculation> const& calculations) override
+	{
+		auto count = 0ll;
+		for (auto const& calculation : calculations)
 		{
-			Calculation calculation{line};
 			if (calculation.valid())
 				count += calculation.result;
 		}
@@ -97,16 +161,11 @@ public:
 		return count;
 	}
 
-	long long partTwo(const Input& input) override
+	long long partTwo(std::vector<Calculation> const& calculations) override
 	{
-		if (input.lines.empty())
-			return -1;
-
-
 		auto count = 0ll;
-		for (auto const& line : input.lines)
+		for (auto const& calculation : calculations)
 		{
-			Calculation calculation{line};
 			if (calculation.validP2())
 				count += calculation.result;
 		}
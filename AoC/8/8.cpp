@@ -0,0 +1,4 @@
+#include "8.h"
+#include "Registry.h"
+
+static Registration<8, Eight> const registration{__DATE__ " " __TIME__};
@@ -5,29 +5,22 @@
 class AntennaMap : public Grid
 {
 public:
-	AntennaMap(std::vector<std::string> const& input, bool convertToInt)
+	AntennaMap(std::vector<std::string_view> const& input, bool convertToInt)
 		: Grid(input, convertToInt)
 	{
-		for (auto const& line : data)
-		{
-			for (auto const& coordinate : line)
-			{
-				if (coordinate.strValue == ".")
-					continue;
-
-				antennas.push_back(coordinate);
-			}
-		}
+		for (auto const location : locations())
+			if (get(location) != '.')
+				antennas.push_back(location);
 	}
 
-	virtual std::set<Location> calcAntinodes(Coordinate const& first, Coordinate const& second)
+	virtual std::unordered_set<Location> calcAntinodes(Location const& first, Location const& second)
 	{
-		std::set<Location> antinodes;
+		std::unordered_set<Location> antinodes;
 		for (auto const x : range(xMax()))
 		{
 			for (auto const y : range(yMax()))
 			{
-				auto const& possibleAntinode = get(y, x);
+				auto const possibleAntinode = Location{y, x};
 				if (std::abs((first.getDirection(possibleAntinode) - possibleAntinode.getDirection(second))) >
 					DBL_EPSILON)
 					continue;
@@ -36,59 +29,61 @@ public:
 				auto const secondDistance = second.getDistance(possibleAntinode);
 				if (std::abs((2 * firstDistance - secondDistance)) < DBL_EPSILON || std::abs(
 					(2 * secondDistance - firstDistance)) < DBL_EPSILON)
-					antinodes.insert(possibleAntinode.location);
+					antinodes.insert(possibleAntinode);
 			}
 		}
 		return antinodes;
 	}
 
-	std::set<Location> findAntinodes()
+	std::unordered_set<Location> findAntinodes()
 	{
-		std::set<Location> antinodes;
+		std::unordered_set<Location> antinodes;
 		for (auto const& firstAntenna : antennas)
 		{
 			for (auto const& secondAntenna : antennas)
 			{
-				if (firstAntenna.location == secondAntenna.location || firstAntenna.strValue != secondAntenna.strValue)
+				if (firstAntenna == secondAntenna || get(firstAntenna) != get(secondAntenna))
 					continue;
-				antinodes.insert_range(calcAntinodes(firstAntenna, secondAntenna));
+
+				auto const newAntinodes = calcAntinodes(firstAntenna, secondAntenna);
+				antinodes.insert(newAntinodes.begin(), newAntinodes.end());
 			}
 		}
 		return antinodes;
 	}
 
-	void drawAntinodes(std::set<Location> const& antinodes) const
+	void drawAntinodes(std::unordered_set<Location> const& antinodes) const
 	{
 		auto copy = *this;
 		for (auto const& antinode : antinodes)
-			copy.get(antinode).strValue = "#";
+			copy.get(antinode) = '#';
 		copy.draw();
 	}
 
-	std::vector<Coordinate> antennas;
+	std::vector<Location> antennas;
 };
 
 class HarmonicAntennaMap : public AntennaMap
 {
 public:
-	HarmonicAntennaMap(std::vector<std::string> const& input, bool convertToInt)
+	HarmonicAntennaMap(std::vector<std::string_view> const& input, bool convertToInt)
 		: AntennaMap(input, convertToInt)
 	{
 	}
 
-	std::set<Location> calcAntinodes(Coordinate const& first, Coordinate const& second) override
+	std::unordered_set<Location> calcAntinodes(Location const& first, Location const& second) override
 	{
-		std::set<Location> antinodes;
-		antinodes.insert(first.location);
-		antinodes.insert(second.location);
+		std::unordered_set<Location> antinodes;
+		antinodes.insert(first);
+		antinodes.insert(second);
 
 		for (auto const x : range(xMax()))
 		{
 			for (auto const y : range(yMax()))
 			{
-				auto const& possibleAntinode = get(y, x);
+				auto const possibleAntinode = Location{y, x};
 				if (std::abs((first.getDirection(possibleAntinode) - possibleAntinode.getDirection(second))) < 0.00001)
-					antinodes.insert(possibleAntinode.location);
+					antinodes.insert(possibleAntinode);
 			}
 		}
 		return antinodes;
@@ -103,6 +98,19 @@ public:
 	{
 	}
 
+	// Square map of about size cells with scattered antennas
+	static void generate(Generator& generator)
+	{
+		constexpr std::string_view frequencies = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+		auto const side = generator.side();
+		for ([[maybe_unused]] auto _ : range(side))
+		{
+			for ([[maybe_unused]] auto _ : range(side))
+				generator << (generator.chance(0.04) ? generator.pick(frequencies) : '.');
+			generator << '\n';
+		}
+	}
+
 	long long partOne(const Input& input) override
 	{
 		if (input.lines.empty())
@@ -110,7 +118,7 @@ public:
 
 		auto grid = AntennaMap{input.lines, false};
 		auto const antinodes = grid.findAntinodes();
-		grid.drawAntinodes(antinodes);
+		render([&] { grid.drawAntinodes(antinodes); });
 		return antinodes.size();
 	}
 
@@ -121,7 +129,7 @@ public:
 
 		auto grid = HarmonicAntennaMap{input.lines, false};
 		auto const antinodes = grid.findAntinodes();
-		grid.drawAntinodes(antinodes);
+		render([&] { grid.drawAntinodes(antinodes); });
 		return antinodes.size();
 	}
 };
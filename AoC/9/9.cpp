@@ -0,0 +1,4 @@
+#include "9.h"
+#include "Registry.h"
+
+static Registration<9, Nine> const registration{__DATE__ " " __TIME__};
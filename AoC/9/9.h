@@ -18,18 +18,18 @@ struct File
 class Disk
 {
 public:
-	Disk(std::string const& input)
+	Disk(std::string_view const input)
 	{
 		int id = 0;
 		bool freeSpace = false;
 		int index = 0;
 		for (auto const& ch : input)
 		{
-			auto const size = std::stoi(std::string{ch});
+			auto const size = ch - '0';
 			if (!freeSpace)
 			{
 				auto const block = Block{false, id};
-				blocks.insert_range(blocks.end(), std::vector<Block>(size, block));
+				blocks.insert(blocks.end(), size, block);
 
 				auto const file = File{id, index, index + size, size};
 				files.push_back(file);
@@ -39,7 +39,7 @@ public:
 			else
 			{
 				constexpr auto block = Block{true, -1};
-				blocks.insert_range(blocks.end(), std::vector<Block>(size, block));
+				blocks.insert(blocks.end(), size, block);
 
 				auto const file = File{id, index, index + size, size};
 				spaces.push_back(file);
@@ -173,6 +173,14 @@ public:
 	{
 	}
 
+	// Disk map of size digits
+	static void generate(Generator& generator)
+	{
+		for (auto const index : range(generator.size()))
+			generator << static_cast<char>('0' + generator.number(index % 2 == 0 ? 1 : 0, 9));
+		generator << '\n';
+	}
+
 	long long partOne(const Input& input) override
 	{
 		if (input.lines.empty())
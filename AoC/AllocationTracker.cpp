@@ -0,0 +1,87 @@
+#include "AllocationTracker.h"
+
+#ifdef AOC_TRACK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Every block starts with a header that is a multiple of the alignment. Its last bytes hold the requested size,
+	// so delete knows how much is freed.
+	size_t headerSize(size_t const alignment)
+	{
+		return (std::max)(alignment, size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+	}
+
+	void* allocate(size_t const size, size_t const alignment)
+	{
+		auto const header = headerSize(alignment);
+		auto const total = (size + 2 * header - 1) / header * header;
+		while (true)
+		{
+#ifdef _WIN32
+			auto const block = static_cast<char*>(_aligned_malloc(total, header));
+#else
+			auto const block = static_cast<char*>(std::aligned_alloc(header, total));
+#endif
+			if (block)
+			{
+				*reinterpret_cast<size_t*>(block + header - sizeof(size_t)) = size;
+				AllocationTracker::allocated(size);
+				return block + header;
+			}
+
+			auto const handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc{};
+			handler();
+		}
+	}
+
+	void deallocate(void* const pointer, size_t const alignment) noexcept
+	{
+		if (!pointer)
+			return;
+
+		auto const header = headerSize(alignment);
+		auto const block = static_cast<char*>(pointer) - header;
+		AllocationTracker::freed(*reinterpret_cast<size_t*>(block + header - sizeof(size_t)));
+#ifdef _WIN32
+		_aligned_free(block);
+#else
+		std::free(block);
+#endif
+	}
+}
+
+// The array and nothrow forms forward to these in both the MSVC and GNU runtimes
+void* operator new(size_t const size)
+{
+	return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t const size, std::align_val_t const alignment)
+{
+	return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* const pointer) noexcept
+{
+	deallocate(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* const pointer, size_t) noexcept
+{
+	deallocate(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* const pointer, std::align_val_t const alignment) noexcept
+{
+	deallocate(pointer, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* const pointer, size_t, std::align_val_t const alignment) noexcept
+{
+	deallocate(pointer, static_cast<size_t>(alignment));
+}
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+// Define AOC_TRACK_ALLOCATIONS to count heap allocations. Global operator new and delete are then replaced (see
+// AllocationTracker.cpp) and every allocation is counted for the thread that makes it. Memory freed by another
+// thread than the one that allocated it is counted where it is freed.
+#ifdef AOC_TRACK_ALLOCATIONS
+inline constexpr bool allocationTrackingEnabled = true;
+#else
+inline constexpr bool allocationTrackingEnabled = false;
+#endif
+
+struct AllocationStats
+{
+	long long count{0};
+	long long bytes{0};
+	long long peak{0}; // highest number of live bytes above what was live when the phase began
+};
+
+class AllocationTracker
+{
+public:
+	// Starts a new phase on this thread
+	static void begin()
+	{
+		auto& current = counters();
+		current.count = 0;
+		current.bytes = 0;
+		current.phaseStart = current.live;
+		current.peak = current.live;
+	}
+
+	static AllocationStats end()
+	{
+		auto const& current = counters();
+		return {current.count, current.bytes, current.peak - current.phaseStart};
+	}
+
+	static void allocated(size_t const size)
+	{
+		auto& current = counters();
+		++current.count;
+		current.bytes += static_cast<long long>(size);
+		current.live += static_cast<long long>(size);
+		current.peak = (std::max)(current.peak, current.live);
+	}
+
+	static void freed(size_t const size)
+	{
+		counters().live -= static_cast<long long>(size);
+	}
+
+private:
+	struct Counters
+	{
+		long long count;
+		long long bytes;
+		long long live;
+		long long peak;
+		long long phaseStart;
+	};
+
+	// Constant initialised so it can be used from operator new before anything else is set up
+	static Counters& counters()
+	{
+		constinit thread_local Counters current{};
+		return current;
+	}
+};
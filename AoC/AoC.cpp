@@ -1,82 +1,192 @@
 // AoC.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
 
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 
-#include "1/1.h"
-#include "10/10.h"
-#include "11/11.h"
-#include "12/12.h"
-#include "13/13.h"
-#include "14/14.h"
-#include "15/15.h"
-#include "16/16.h"
-#include "17/17.h"
-#include "18/18.h"
-#include "2/2.h"
-#include "3/3.h"
-#include "4/4.h"
-#include "5/5.h"
-#include "6/6.h"
-#include "7/7.h"
-#include "8/8.h"
-#include "9/9.h"
+#include "Benchmark.h"
+#include "Registry.h"
+#include "Runner.h"
 
-std::unique_ptr<Puzzle> getPuzzle(int const day)
+void runInteractive()
 {
-	switch (day)
+	std::cout << "Day?\n";
+	int day;
+	std::cin >> day;
+	auto const puzzle = getPuzzle(day);
+	if (!puzzle)
 	{
-	case 1:
-		return std::make_unique<One>();
-	case 2:
-		return std::make_unique<Two>();
-	case 3:
-		return std::make_unique<Three>();
-	case 4:
-		return std::make_unique<Four>();
-	case 5:
-		return std::make_unique<Five>();
-	case 6:
-		return std::make_unique<Six>();
-	case 7:
-		return std::make_unique<Seven>();
-	case 8:
-		return std::make_unique<Eight>();
-	case 9:
-		return std::make_unique<Nine>();
-	case 10:
-		return std::make_unique<Ten>();
-	case 11:
-		return std::make_unique<Eleven>();
-	case 12:
-		return std::make_unique<Twelve>();
-	case 13:
-		return std::make_unique<Thirteen>();
-	case 14:
-		return std::make_unique<Fourteen>();
-	case 15:
-		return std::make_unique<Fifteen>();
-	case 16:
-		return std::make_unique<Sixteen>();
-	case 17:
-		return std::make_unique<Seventeen>();
-	case 18:
-		return std::make_unique<Eighteen>();
+		std::cerr << "There is no puzzle for day " << day << "\n";
+		return;
 	}
-
-	return {};
+	auto const results = puzzle->getResults();
+	std::cout << "Part one Sample result for day " << day << " is " << *results.samplePartOne << "\n";
+	std::cout << "Part one Result for day " << day << " is " << *results.partOne << "\n";
+	std::cout << "Part two Sample result for day " << day << " is " << *results.samplePartTwo << "\n";
+	std::cout << "Part two Result for day " << day << " is " << *results.partTwo << "\n";
 }
 
-int main()
+// Without arguments the day is asked for on stdin. Otherwise the given days are run in parallel:
+//   AoC all
+//   AoC 1 4-7 --threads 4
+// --real or --sample restricts the run to one input, --part 1 or --part 2 to one part.
+// --list prints the available days, --help the options.
+// --bench benchmarks the days instead, see BenchmarkSettings for --warmup, --iterations, --min-time and --json.
+// --generate <day> writes a synthetic input of --size (lines, cells or bytes, depending on the day) with --seed to
+// --output or stdout. --input <path> runs the days on such an input instead of their own.
+// --stream <day> solves a line based day from stdin (or --input) in constant memory, e.g. for generated inputs that
+// don't fit in memory.
+// Results are cached in .aoccache per day, input and build. --no-cache neither reads nor writes it, --clear-cache
+// empties it first.
+// --param key=value sets a day specific parameter for generating and solving, e.g. width and height for day 14.
+// Drawings (at Render verbosity) are shown at most --fps times a second, or written to --record <path> instead.
+// --playback <path> shows such a recording at --fps.
+constexpr auto usage =
+	"usage: AoC [all | <day> | <first>-<last>]... [--threads n] [--real | --sample] [--part 1|2] [--list] [--help]\n"
+	"           [--bench [--warmup n] [--iterations n] [--min-time seconds] [--json path]]\n"
+	"           [--generate <day> [--size n] [--seed n] [--output path]] [--input path] [--stream <day>]\n"
+	"           [--no-cache] [--clear-cache] [--param name=value]... [--fps n] [--record path] [--playback path]\n";
+
+int main(int const argc, char* argv[])
 {
-	std::cout << "Day?\n";
-	int day;
-	std::cin >> day;
-	auto const results = getPuzzle(day)->getResults();
-	std::cout << "Part one Sample result for day " << day << " is " << results.samplePartOne << "\n";
-	std::cout << "Part one Result for day " << day << " is " << results.partOne << "\n";
-	std::cout << "Part two Sample result for day " << day << " is " << results.samplePartTwo << "\n";
-	std::cout << "Part two Result for day " << day << " is " << results.partTwo << "\n";
+	if (argc < 2)
+	{
+		runInteractive();
+		return 0;
+	}
+
+	std::vector<std::string> dayArguments;
+	RunMode mode;
+	BenchmarkSettings benchmarkSettings;
+	bool benchmark = false;
+	int generateDay = 0;
+	int streamDay = 0;
+	GeneratorSettings generatorSettings;
+	std::string outputPath;
+	unsigned numThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	RenderSettings renderSettings;
+	std::string playbackPath;
+	std::vector<int> days;
+	try
+	{
+		for (auto index = 1; index < argc; ++index)
+		{
+			std::string const argument = argv[index];
+			if (argument == "--help" || argument == "-h")
+			{
+				std::cout << usage;
+				return 0;
+			}
+			if (argument == "--list")
+			{
+				for (auto const day : Registry::days())
+					std::cout << day << "\n";
+				return 0;
+			}
+			if (argument == "--threads" && index + 1 < argc)
+				numThreads = parseArgument(argument, argv[++index], 1u);
+			else if (argument == "--bench")
+				benchmark = true;
+			else if (argument == "--warmup" && index + 1 < argc)
+				benchmarkSettings.warmup = parseArgument(argument, argv[++index], 0);
+			else if (argument == "--iterations" && index + 1 < argc)
+				benchmarkSettings.maxIterations = parseArgument(argument, argv[++index], 1);
+			else if (argument == "--min-time" && index + 1 < argc)
+				benchmarkSettings.minTime = std::chrono::duration<double>(parseArgument(argument, argv[++index], 0.0));
+			else if (argument == "--json" && index + 1 < argc)
+				benchmarkSettings.jsonPath = argv[++index];
+			else if (argument == "--no-cache")
+				mode.cache = false;
+			else if (argument == "--clear-cache")
+				ResultCache{}.clear();
+			else if (argument == "--real")
+				mode.sample = false;
+			else if (argument == "--sample")
+				mode.real = false;
+			else if (argument == "--generate" && index + 1 < argc)
+				generateDay = registeredDay(parseArgument(argument, argv[++index], 1, 25));
+			else if (argument == "--stream" && index + 1 < argc)
+				streamDay = registeredDay(parseArgument(argument, argv[++index], 1, 25));
+			else if (argument == "--size" && index + 1 < argc)
+				generatorSettings.size = parseArgument(argument, argv[++index], 0ll);
+			else if (argument == "--seed" && index + 1 < argc)
+				generatorSettings.seed = parseArgument(argument, argv[++index], 0ull);
+			else if (argument == "--output" && index + 1 < argc)
+				outputPath = argv[++index];
+			else if (argument == "--input" && index + 1 < argc)
+				mode.realInput = argv[++index];
+			else if (argument == "--param" && index + 1 < argc)
+			{
+				auto const parameter = split(argv[++index], "=");
+				auto part = parameter.begin();
+				std::string const name{*part};
+				if (++part == parameter.end())
+					throw std::invalid_argument("--param expects name=value");
+				mode.parameters[name] = NumberScanner{*part}.get();
+			}
+			else if (argument == "--fps" && index + 1 < argc)
+				renderSettings.maxFramesPerSecond = parseArgument(argument, argv[++index], 0.0);
+			else if (argument == "--record" && index + 1 < argc)
+				renderSettings.recording = argv[++index];
+			else if (argument == "--playback" && index + 1 < argc)
+				playbackPath = argv[++index];
+			else if (argument == "--part" && index + 1 < argc)
+			{
+				auto const part = parseArgument(argument, argv[++index], 1, 2);
+				mode.partOne = part == 1;
+				mode.partTwo = part == 2;
+			}
+			else
+				dayArguments.push_back(argument);
+		}
+		days = parseDays(dayArguments);
+	}
+	catch (std::exception const& error)
+	{
+		std::cerr << error.what() << "\n" << usage;
+		return 1;
+	}
+
+	if (!playbackPath.empty())
+	{
+		FrameRenderer::play(playbackPath, renderSettings.maxFramesPerSecond);
+		return 0;
+	}
+	FrameRenderer::instance().configure(renderSettings);
+
+	if (generateDay != 0)
+	{
+		auto const entry = Registry::find(generateDay); // checked while parsing the arguments
+		generatorSettings.parameters = mode.parameters;
+		std::ofstream file;
+		if (!outputPath.empty())
+			file.open(outputPath, std::ios::binary);
+		else
+			std::ios::sync_with_stdio(false);
+
+		Generator generator{outputPath.empty() ? std::cout : file, generatorSettings};
+		entry->generate(generator);
+		return 0;
+	}
+
+	if (streamDay != 0)
+	{
+		if (!mode.realInput.empty())
+		{
+			std::ifstream file{mode.realInput, std::ios::binary};
+			return runStream(streamDay, mode, file) ? 0 : 1;
+		}
+
+		std::ios::sync_with_stdio(false);
+		return runStream(streamDay, mode, std::cin) ? 0 : 1;
+	}
+
+	if (benchmark)
+		runBenchmarks(days, mode, benchmarkSettings);
+	else
+		runBatch(days, mode, numThreads);
+	return 0;
 }
 
 // Run program: Ctrl + F5 or Debug > Start Without Debugging menu
@@ -0,0 +1,146 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Runner.h"
+
+struct BenchmarkSettings
+{
+	int warmup{1};
+	int maxIterations{100};
+	std::chrono::duration<double> minTime{1.0};
+	std::string jsonPath;
+};
+
+struct BenchmarkResult
+{
+	int day;
+	bool sample;
+	int part;
+	long long result;
+	size_t inputBytes;
+	int iterations;
+	std::chrono::nanoseconds min;
+	std::chrono::nanoseconds median;
+	std::chrono::nanoseconds p90;
+	std::chrono::nanoseconds p99;
+	std::chrono::nanoseconds mean;
+
+	double throughput() const
+	{
+		auto const seconds = std::chrono::duration<double>(median).count();
+		return seconds > 0 ? static_cast<double>(inputBytes) / seconds : 0.0;
+	}
+};
+
+// Nearest rank percentile of sorted samples
+inline std::chrono::nanoseconds percentile(std::vector<std::chrono::nanoseconds> const& sorted, double const fraction)
+{
+	auto const rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+	return sorted[std::clamp(rank, size_t{1}, sorted.size()) - 1];
+}
+
+// Times one part on one input. The parsed model is thrown away before every run, so parsing is part of what is
+// measured just like it is in a normal run.
+// Parts are called through the registry's statically dispatched entry points.
+inline BenchmarkResult benchmarkPart(PuzzleEntry const& entry, Puzzle& puzzle, Input const& input, bool const sample,
+                                     int const part, BenchmarkSettings const& settings)
+{
+	auto const runOnce = [&]
+	{
+		input.clearModels();
+		return part == 1 ? entry.partOne(puzzle, input) : entry.partTwo(puzzle, input);
+	};
+
+	for ([[maybe_unused]] auto _ : range(settings.warmup))
+		runOnce();
+
+	long long result = 0;
+	std::vector<std::chrono::nanoseconds> samples;
+	auto const start = std::chrono::steady_clock::now();
+	while (samples.size() < static_cast<size_t>(settings.maxIterations) &&
+		(samples.empty() || std::chrono::steady_clock::now() - start < settings.minTime))
+	{
+		auto const iterationStart = std::chrono::steady_clock::now();
+		result = runOnce();
+		samples.push_back(std::chrono::steady_clock::now() - iterationStart);
+	}
+
+	std::ranges::sort(samples);
+	std::chrono::nanoseconds total{};
+	for (auto const& sampleTime : samples)
+		total += sampleTime;
+
+	return {
+		puzzle.day, sample, part, result, input.buffer.size(), static_cast<int>(samples.size()), samples.front(),
+		percentile(samples, 0.5), percentile(samples, 0.9), percentile(samples, 0.99),
+		total / static_cast<long long>(samples.size())
+	};
+}
+
+inline void writeJson(std::vector<BenchmarkResult> const& results, BenchmarkSettings const& settings)
+{
+	std::ofstream out{settings.jsonPath};
+	out << "{\n  \"warmup\": " << settings.warmup << ",\n  \"benchmarks\": [";
+	for (auto const index : range(results.size()))
+	{
+		auto const& result = results[index];
+		out << (index > 0 ? "," : "") << "\n    {";
+		out << std::format("\"day\": {}, \"input\": \"{}\", \"part\": {}, \"result\": {}, ", result.day,
+		                   result.sample ? "sample" : "real", result.part, result.result);
+		out << std::format("\"iterations\": {}, \"min_ns\": {}, \"median_ns\": {}, \"p90_ns\": {}, \"p99_ns\": {}, ",
+		                   result.iterations, result.min.count(), result.median.count(), result.p90.count(),
+		                   result.p99.count());
+		out << std::format("\"mean_ns\": {}, \"input_bytes\": {}, \"bytes_per_second\": {:.1f}}}", result.mean.count(),
+		                   result.inputBytes, result.throughput());
+	}
+	out << "\n  ]\n}\n";
+}
+
+// Benchmarks days one after the other (never in parallel, so they don't disturb each other).
+inline void runBenchmarks(std::vector<int> const& days, RunMode const& mode, BenchmarkSettings const& settings)
+{
+	std::vector<BenchmarkResult> results;
+	for (auto const day : days)
+	{
+		auto const entry = Registry::find(day);
+		if (!entry)
+			continue;
+
+		auto const puzzle = entry->create();
+		puzzle->configure(mode);
+		for (auto const sample : {true, false})
+		{
+			if (sample ? !mode.sample : !mode.real)
+				continue;
+
+			auto const& input = sample ? puzzle->getSample() : puzzle->getTest();
+			for (auto const part : {1, 2})
+				if (part == 1 ? mode.partOne : mode.partTwo)
+					results.push_back(benchmarkPart(*entry, *puzzle, input, sample, part, settings));
+		}
+	}
+
+	auto const milliseconds = [](std::chrono::nanoseconds const duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+	std::cout << std::format("\n{:>4}  {:<7}{:>5}{:>7}{:>12}{:>12}{:>12}{:>12}{:>14}\n", "Day", "Input", "Part", "Runs",
+	                         "Min (ms)", "Median (ms)", "P90 (ms)", "P99 (ms)", "MB/s");
+	for (auto const& result : results)
+	{
+		std::cout << std::format("{:>4}  {:<7}{:>5}{:>7}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}{:>14.1f}\n", result.day,
+		                         result.sample ? "sample" : "real", result.part, result.iterations,
+		                         milliseconds(result.min), milliseconds(result.median), milliseconds(result.p90),
+		                         milliseconds(result.p99), result.throughput() / 1e6);
+	}
+
+	if (!settings.jsonPath.empty())
+		writeJson(results, settings);
+}
@@ -0,0 +1,225 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct RenderSettings
+{
+	double maxFramesPerSecond{0}; // 0 shows every frame
+	std::filesystem::path recording; // when set, frames are written here instead of to the terminal
+};
+
+// Draws grids of characters to the terminal as frames of an animation. A frame is built in one buffer that is reused
+// and written at once. Only the cells that changed since the previous frame are written, unless the size changed.
+// Frames that come faster than the frame rate cap are skipped, the last of them is shown by flush (at the latest when the
+// program ends).
+// In headless mode (a recording is set) every frame goes to a file instead, which play shows later.
+class FrameRenderer
+{
+public:
+	static FrameRenderer& instance()
+	{
+		static FrameRenderer renderer;
+		return renderer;
+	}
+
+	~FrameRenderer()
+	{
+		flush();
+	}
+
+	void configure(RenderSettings settings)
+	{
+		std::lock_guard lock(mutex);
+		this->settings = std::move(settings);
+		recording.close();
+		if (!this->settings.recording.empty())
+			recording.open(this->settings.recording, std::ios::binary | std::ios::trunc);
+	}
+
+	// cellAt(y, x) gives the character of each cell
+	template <typename CellAt>
+	void draw(int const height, int const width, CellAt&& cellAt)
+	{
+		std::lock_guard lock(mutex);
+		frame.resize(static_cast<size_t>(height) * width);
+		for (auto y = 0; y < height; ++y)
+			for (auto x = 0; x < width; ++x)
+				frame[static_cast<size_t>(y) * width + x] = cellAt(y, x);
+		frameHeight = height;
+		frameWidth = width;
+
+		if (recording.is_open())
+		{
+			record();
+			return;
+		}
+
+		auto const now = std::chrono::steady_clock::now();
+		auto const interval = std::chrono::duration<double>(1 / settings.maxFramesPerSecond);
+		if (settings.maxFramesPerSecond > 0 && now - lastShown < interval)
+		{
+			pending = true;
+			return;
+		}
+		lastShown = now;
+		show();
+	}
+
+	// Shows a frame that was dropped because of the frame rate cap
+	void flush()
+	{
+		std::lock_guard lock(mutex);
+		if (pending)
+			show();
+	}
+
+	// Shows the frames of a recording at the configured frame rate
+	static void play(std::filesystem::path const& path, double const framesPerSecond)
+	{
+		auto& renderer = instance();
+		std::ifstream file{path, std::ios::binary};
+		auto const interval = std::chrono::duration<double>(framesPerSecond > 0 ? 1 / framesPerSecond : 0);
+		int height;
+		int width;
+		std::string line;
+		std::vector<std::string> rows;
+		while (file >> height >> width && std::getline(file, line))
+		{
+			rows.resize(height);
+			for (auto& row : rows)
+				std::getline(file, row);
+
+			auto const next = std::chrono::steady_clock::now() + interval;
+			renderer.draw(height, width, [&](int const y, int const x) { return rows[y][x]; });
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+private:
+	FrameRenderer()
+	{
+		buffer.reserve(1 << 16);
+	}
+
+	void show()
+	{
+		pending = false;
+		buffer.clear();
+		if (frameHeight != shownHeight || frameWidth != shownWidth)
+			writeFrame();
+		else
+			writeChanges();
+
+		shown.swap(frame); // draw fills all of frame again
+		shownHeight = frameHeight;
+		shownWidth = frameWidth;
+		std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size())).flush();
+	}
+
+	// The whole frame below the cursor, over the previous frame if there is one
+	void writeFrame()
+	{
+		buffer += "\033[?25l"; // hide the cursor
+		if (shownHeight > 0)
+			buffer += std::format("\033[{}A", shownHeight);
+		buffer += "\r\033[J";
+		for (auto y = 0; y < frameHeight; ++y)
+		{
+			int colour = 0;
+			for (auto x = 0; x < frameWidth; ++x)
+				writeCell(cell(frame, y, x), colour);
+			buffer += "\033[0m\n";
+		}
+		buffer += "\033[?25h";
+	}
+
+	// Moves up to the changed cells and writes them, then goes back below the frame
+	void writeChanges()
+	{
+		buffer += "\033[?25l";
+		auto cursorRow = frameHeight; // the line below the frame
+		for (auto y = 0; y < frameHeight; ++y)
+		{
+			int colour = 0;
+			auto column = -1;
+			for (auto x = 0; x < frameWidth; ++x)
+			{
+				if (cell(frame, y, x) == cell(shown, y, x))
+					continue;
+
+				moveToRow(cursorRow, y);
+				if (column != x)
+					buffer += std::format("\033[{}G", x + 1);
+				writeCell(cell(frame, y, x), colour);
+				column = x + 1;
+			}
+			if (colour != 0)
+				buffer += "\033[0m";
+		}
+		moveToRow(cursorRow, frameHeight);
+		buffer += "\r\033[?25h";
+	}
+
+	void moveToRow(int& cursorRow, int const row)
+	{
+		if (row < cursorRow)
+			buffer += std::format("\033[{}A", cursorRow - row);
+		else if (row > cursorRow)
+			buffer += std::format("\033[{}B", row - cursorRow);
+		cursorRow = row;
+	}
+
+	void writeCell(char const value, int& colour)
+	{
+		auto& assigned = colours[static_cast<unsigned char>(value)];
+		if (assigned == 0)
+			assigned = static_cast<uint8_t>(31 + (nextColour++ % 6)); // Cycle through 6 colors (31-36)
+		if (assigned != colour)
+		{
+			buffer += std::format("\033[{}m", static_cast<int>(assigned));
+			colour = assigned;
+		}
+		buffer += value;
+	}
+
+	void record()
+	{
+		buffer.clear();
+		buffer += std::format("{} {}\n", frameHeight, frameWidth);
+		for (auto y = 0; y < frameHeight; ++y)
+		{
+			buffer.append(frame.data() + static_cast<size_t>(y) * frameWidth, frameWidth);
+			buffer += '\n';
+		}
+		recording.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	}
+
+	char cell(std::vector<char> const& cells, int const y, int const x) const
+	{
+		return cells[static_cast<size_t>(y) * frameWidth + x];
+	}
+
+	std::mutex mutex;
+	RenderSettings settings;
+	std::ofstream recording;
+	std::vector<char> frame;
+	int frameHeight{0};
+	int frameWidth{0};
+	std::vector<char> shown;
+	int shownHeight{0};
+	int shownWidth{0};
+	bool pending{false};
+	std::chrono::steady_clock::time_point lastShown;
+	std::string buffer;
+	std::array<uint8_t, 256> colours{};
+	int nextColour{1};
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils.h"
+
+struct GeneratorSettings
+{
+	long long size{1000};
+	unsigned long long seed{0};
+	Parameters parameters;
+};
+
+// Writes a synthetic puzzle input. Days implement `static void generate(Generator&)`; what size means is up to the
+// day (lines, grid cells, bytes...). Output is buffered so inputs of hundreds of MB are written in big chunks.
+class Generator
+{
+public:
+	Generator(std::ostream& out, GeneratorSettings const& settings) :
+		settings(settings),
+		random(settings.seed),
+		out(out)
+	{
+		buffer.reserve(bufferSize + 64);
+	}
+
+	Generator(Generator const&) = delete;
+	Generator& operator=(Generator const&) = delete;
+
+	~Generator()
+	{
+		flush();
+	}
+
+	long long size() const
+	{
+		return settings.size;
+	}
+
+	// Side of the square grid with size cells
+	long long side() const
+	{
+		return (std::max)(1ll, static_cast<long long>(std::ceil(std::sqrt(static_cast<double>(settings.size)))));
+	}
+
+	long long getParameter(std::string const& name, long long const fallback) const
+	{
+		auto const it = settings.parameters.find(name);
+		return it == settings.parameters.end() ? fallback : it->second;
+	}
+
+	// Uniform in [min, max]
+	long long number(long long const min, long long const max)
+	{
+		return std::uniform_int_distribution<long long>{min, max}(random);
+	}
+
+	bool chance(double const probability)
+	{
+		return std::bernoulli_distribution{probability}(random);
+	}
+
+	template <typename T>
+	T const& pick(std::vector<T> const& options)
+	{
+		return options[number(0, static_cast<long long>(options.size()) - 1)];
+	}
+
+	char pick(std::string_view const options)
+	{
+		return options[number(0, static_cast<long long>(options.size()) - 1)];
+	}
+
+	Generator& operator<<(std::string_view const text)
+	{
+		buffer += text;
+		flushIfFull();
+		return *this;
+	}
+
+	Generator& operator<<(char const ch)
+	{
+		buffer += ch;
+		flushIfFull();
+		return *this;
+	}
+
+	Generator& operator<<(std::integral auto const value)
+	{
+		char digits[24];
+		auto const end = std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+		buffer.append(digits, end);
+		flushIfFull();
+		return *this;
+	}
+
+	GeneratorSettings const settings;
+	std::mt19937_64 random;
+
+private:
+	static constexpr size_t bufferSize = 1 << 20;
+
+	void flushIfFull()
+	{
+		if (buffer.size() >= bufferSize)
+			flush();
+	}
+
+	void flush()
+	{
+		out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		buffer.clear();
+	}
+
+	std::ostream& out;
+	std::string buffer;
+};
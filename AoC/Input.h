@@ -1,52 +1,301 @@
 #pragma once
 
-#include <fstream>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
+#include "Generator.h"
+#include "MappedFile.h"
+#include "Stream.h"
+#include "ThreadPool.h"
 #include "utils.h"
 
+// Which of the four computations to run. Inputs that are not needed are never read.
+struct RunMode
+{
+	bool sample{true};
+	bool real{true};
+	bool partOne{true};
+	bool partTwo{true};
+	Parameters parameters;
+	std::filesystem::path realInput; // Replaces the day's own input when set, e.g. with a generated one
+	bool cache{true}; // Whether the runner may use and store cached results
+};
+
 struct Results
 {
-	long long samplePartOne;
-	long long samplePartTwo;
-	long long partOne;
-	long long partTwo;
+	std::optional<long long> samplePartOne;
+	std::optional<long long> samplePartTwo;
+	std::optional<long long> partOne;
+	std::optional<long long> partTwo;
+
+	// In the order above
+	std::optional<long long>& at(int const index)
+	{
+		std::array const results{&samplePartOne, &samplePartTwo, &partOne, &partTwo};
+		return *results[index];
+	}
 };
 
 
+// Lines of a puzzle input as views into one contiguous buffer. Inputs read from disk view straight into the memory
+// mapped file, inputs built from strings own a joined copy. Copies share the underlying buffer.
 class Input
 {
 public:
-	Input(int const day, bool const sample)
+	Input(int const day, bool const sample) :
+		Input(std::filesystem::path{std::format("{}/{}{}.txt", day, day, sample ? "Sample" : "")})
+	{
+	}
+
+	explicit Input(std::filesystem::path const& path)
+	{
+		auto const file = std::make_shared<MappedFile const>(path);
+		buffer = file->view();
+		storage = file;
+		splitLines();
+	}
+
+	explicit Input(std::vector<std::string> const& inputLines)
+	{
+		auto joined = std::make_shared<std::string>();
+		for (auto const& line : inputLines)
+			(*joined += line) += '\n';
+		buffer = *joined;
+		storage = joined;
+		splitLines();
+	}
+
+	// Returns the Model parsed from this input, calling parse only the first time it is asked for. Models are kept per
+	// type and shared by all copies of the input, so both parts of a day can use the same one.
+	template <typename Model, typename Parse>
+	Model const& getModel(Parse&& parse) const
+	{
+		std::shared_ptr<ModelSlot> slot;
+		{
+			std::lock_guard lock(models->mutex);
+			auto& entry = models->slots[std::type_index(typeid(Model))];
+			if (!entry)
+				entry = std::make_shared<ModelSlot>();
+			slot = entry;
+		}
+		std::call_once(slot->built, [&] { slot->model = std::shared_ptr<Model const>(new Model(parse())); });
+		return *static_cast<Model const*>(slot->model.get());
+	}
+
+	void clearModels() const
 	{
-		std::string line;
-		std::ifstream input;
-		auto const filename = std::format("{}/{}{}.txt", day, day, sample ? "Sample" : "");
-		input.open(filename);
-		while (std::getline(input, line))
+		std::lock_guard lock(models->mutex);
+		models->slots.clear();
+	}
+
+	std::string_view buffer;
+	std::vector<std::string_view> lines;
+
+private:
+	struct ModelSlot
+	{
+		std::once_flag built;
+		std::shared_ptr<void const> model;
+	};
+
+	struct ModelCache
+	{
+		std::mutex mutex;
+		std::unordered_map<std::type_index, std::shared_ptr<ModelSlot>> slots;
+	};
+
+	// Same line semantics as std::getline: no empty line after a trailing newline, carriage returns are dropped
+	void splitLines()
+	{
+		auto rest = buffer;
+		while (!rest.empty())
+		{
+			auto const end = rest.find('\n');
+			auto line = rest.substr(0, end);
+			if (line.ends_with('\r'))
+				line.remove_suffix(1);
 			lines.push_back(line);
+			if (end == std::string_view::npos)
+				break;
+			rest.remove_prefix(end + 1);
+		}
 	}
 
-	std::vector<std::string> lines;
+	std::shared_ptr<void const> storage;
+	std::shared_ptr<ModelCache> models{std::make_shared<ModelCache>()};
 };
 
 class Puzzle
 {
 public:
 	Puzzle(int const day):
-		sample(day, true),
-		test(day, false)
+		day(day)
 	{
 	}
 
+	virtual ~Puzzle() = default;
+
 	virtual long long partOne(Input const& input) = 0;
 	virtual long long partTwo(Input const& input) = 0;
 
-	Results getResults()
+	// Whether the runner may keep the result of a part (1 or 2) in its cache. Parts that only log their answer (and
+	// return a placeholder) have to run every time, or the answer is never shown.
+	virtual bool cacheable(int /*part*/) const
 	{
-		return {partOne(sample), partTwo(sample), partOne(test), partTwo(test)};
+		return true;
 	}
 
-	Input sample;
-	Input test;
+	Results getResults(RunMode const& mode = {})
+	{
+		return runParts(enabledParts(mode), [](int, auto const& part) { return part(); });
+	}
+
+	// Which computations the mode asks for, in the order of Results
+	static std::array<bool, 4> enabledParts(RunMode const& mode)
+	{
+		return {
+			mode.sample && mode.partOne, mode.sample && mode.partTwo, mode.real && mode.partOne, mode.real && mode.partTwo
+		};
+	}
+
+	// Runs the enabled parts at the same time, on the pool the caller works for or else on a pool of its own. Parts
+	// only share the inputs, the models parsed from them and the static caches some days keep, which are locked.
+	// Every part is run as wrap(index, part), index being the position of its result in Results.
+	template <typename Wrap>
+	Results runParts(std::array<bool, 4> const& enabled, Wrap const& wrap)
+	{
+		// Loaded first, so the parts don't line up behind each other's call_once
+		if (enabled[0] || enabled[1])
+			getSample();
+		if (enabled[2] || enabled[3])
+			getTest();
+
+		std::optional<ThreadPool> ownPool;
+		auto pool = ThreadPool::current();
+		if (!pool)
+			pool = &ownPool.emplace(4u);
+
+		std::array<std::future<long long>, 4> futures;
+		for (auto const index : range(futures.size()))
+		{
+			if (!enabled[index])
+				continue;
+			futures[index] = pool->submit([this, index, &wrap]
+			{
+				auto const& input = index < 2 ? getSample() : getTest();
+				return wrap(index, [&] { return index % 2 == 0 ? partOne(input) : partTwo(input); });
+			});
+		}
+
+		// Every part has to finish before an error is passed on, they use this puzzle
+		Results results;
+		std::exception_ptr error;
+		for (auto const index : range(futures.size()))
+		{
+			if (!enabled[index])
+				continue;
+			try
+			{
+				results.at(index) = pool->wait(futures[index]);
+			}
+			catch (...)
+			{
+				if (!error)
+					error = std::current_exception();
+			}
+		}
+		if (error)
+			std::rethrow_exception(error);
+		return results;
+	}
+
+	void configure(RunMode const& mode)
+	{
+		parameters = mode.parameters;
+		testPath = mode.realInput;
+	}
+
+	// Inputs are read on first access
+	Input const& getSample()
+	{
+		std::call_once(sampleLoaded, [this] { sample.emplace(day, true); });
+		return *sample;
+	}
+
+	Input const& getTest()
+	{
+		std::call_once(testLoaded, [this]
+		{
+			if (testPath.empty())
+				test.emplace(day, false);
+			else
+				test.emplace(testPath);
+		});
+		return *test;
+	}
+
+	// Settings that days would otherwise derive from their input, like grid dimensions
+	long long getParameter(std::string const& name, long long const fallback) const
+	{
+		auto const it = parameters.find(name);
+		return it == parameters.end() ? fallback : it->second;
+	}
+
+	int const day;
+
+private:
+	std::once_flag sampleLoaded;
+	std::once_flag testLoaded;
+	std::optional<Input> sample;
+	std::optional<Input> test;
+	std::filesystem::path testPath;
+	Parameters parameters;
+};
+
+// Puzzle that parses its input once into a Model shared read only by both parts. The model can also carry
+// intermediate results that both parts need, computed while parsing.
+template <typename Model>
+class ParsedPuzzle : public Puzzle
+{
+public:
+	using ModelType = Model;
+
+	ParsedPuzzle(int const day) :
+		Puzzle(day)
+	{
+	}
+
+	virtual Model parse(Input const& input) = 0;
+	virtual long long partOne(Model const& model) = 0;
+	virtual long long partTwo(Model const& model) = 0;
+
+	long long partOne(Input const& input) final
+	{
+		return onModel(input, [&] { return parse(input); }, [&](Model const& model) { return partOne(model); });
+	}
+
+	long long partTwo(Input const& input) final
+	{
+		return onModel(input, [&] { return parse(input); }, [&](Model const& model) { return partTwo(model); });
+	}
+
+	// part(model) for the model of input, which parse() builds on first use; -1 without input. Taking both as
+	// functions lets callers that know the day's type (see staticPartOne) skip the vtable.
+	template <typename Parse, typename Part>
+	static long long onModel(Input const& input, Parse const& parse, Part const& part)
+	{
+		if (input.lines.empty())
+			return -1;
+		return part(input.getModel<Model>(parse));
+	}
 };
@@ -0,0 +1,125 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read only view of a whole file. The file is memory mapped when possible; files that can't be mapped (pipes,
+// special files) are read into memory instead. A missing file gives an empty view.
+class MappedFile
+{
+public:
+	explicit MappedFile(std::filesystem::path const& path)
+	{
+		if (!map(path))
+			read(path);
+	}
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	~MappedFile()
+	{
+		unmap();
+	}
+
+	std::string_view view() const
+	{
+		return {data, size};
+	}
+
+private:
+#ifdef _WIN32
+	bool map(std::filesystem::path const& path)
+	{
+		file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+			return false;
+
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+			return false;
+
+		auto const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+			return false;
+
+		data = static_cast<char const*>(view);
+		size = static_cast<size_t>(fileSize.QuadPart);
+		mapped = true;
+		return true;
+	}
+
+	void unmap()
+	{
+		if (mapped)
+			UnmapViewOfFile(data);
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+	}
+
+	HANDLE file{INVALID_HANDLE_VALUE};
+	HANDLE mapping{nullptr};
+#else
+	bool map(std::filesystem::path const& path)
+	{
+		descriptor = open(path.c_str(), O_RDONLY);
+		if (descriptor < 0)
+			return false;
+
+		struct stat status{};
+		if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size == 0)
+			return false;
+
+		auto const view = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (view == MAP_FAILED)
+			return false;
+
+		madvise(view, status.st_size, MADV_SEQUENTIAL);
+		data = static_cast<char const*>(view);
+		size = static_cast<size_t>(status.st_size);
+		mapped = true;
+		return true;
+	}
+
+	void unmap()
+	{
+		if (mapped)
+			munmap(const_cast<char*>(data), size);
+		if (descriptor >= 0)
+			close(descriptor);
+	}
+
+	int descriptor{-1};
+#endif
+
+	void read(std::filesystem::path const& path)
+	{
+		std::ifstream input{path, std::ios::binary};
+		contents.assign(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+		data = contents.data();
+		size = contents.size();
+	}
+
+	char const* data{nullptr};
+	size_t size{0};
+	bool mapped{false};
+	std::string contents;
+};
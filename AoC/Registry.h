@@ -0,0 +1,106 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Input.h"
+
+// Calls the parts of a known puzzle type without going through the vtable, for benchmarking. Days with a model get
+// their parse and parts called directly as well, through ParsedPuzzle::onModel.
+template <typename T>
+long long staticPartOne(Puzzle& puzzle, Input const& input)
+{
+	auto& typed = static_cast<T&>(puzzle);
+	if constexpr (requires { typename T::ModelType; })
+		return T::onModel(input, [&] { return typed.T::parse(input); },
+		                  [&](typename T::ModelType const& model) { return typed.T::partOne(model); });
+	else
+		return typed.T::partOne(input);
+}
+
+template <typename T>
+long long staticPartTwo(Puzzle& puzzle, Input const& input)
+{
+	auto& typed = static_cast<T&>(puzzle);
+	if constexpr (requires { typename T::ModelType; })
+		return T::onModel(input, [&] { return typed.T::parse(input); },
+		                  [&](typename T::ModelType const& model) { return typed.T::partTwo(model); });
+	else
+		return typed.T::partTwo(input);
+}
+
+// Streaming is optional, days that support it have a createAccumulator() member.
+template <typename T>
+std::unique_ptr<Accumulator> staticCreateAccumulator(Puzzle const& puzzle)
+{
+	return static_cast<T const&>(puzzle).createAccumulator();
+}
+
+using CreateAccumulator = std::unique_ptr<Accumulator> (*)(Puzzle const&);
+
+template <typename T>
+constexpr CreateAccumulator accumulatorFor()
+{
+	if constexpr (requires(T const& typed) { typed.createAccumulator(); })
+		return &staticCreateAccumulator<T>;
+	else
+		return nullptr;
+}
+
+struct PuzzleEntry
+{
+	std::unique_ptr<Puzzle> (*create)();
+	long long (*partOne)(Puzzle&, Input const&);
+	long long (*partTwo)(Puzzle&, Input const&);
+	void (*generate)(Generator&);
+	CreateAccumulator createAccumulator; // nullptr when the day can't stream
+	char const* buildId; // when the day was compiled, cached results of other builds are ignored
+};
+
+// Every day registers itself from its own translation unit (see Registration), so adding a day means adding its
+// .cpp file and nothing else.
+class Registry
+{
+public:
+	static PuzzleEntry const* find(int const day)
+	{
+		auto const it = entries().find(day);
+		return it == entries().end() ? nullptr : &it->second;
+	}
+
+	static std::vector<int> days()
+	{
+		std::vector<int> result;
+		for (auto const day : entries() | std::views::keys)
+			result.push_back(day);
+		return result;
+	}
+
+	static std::map<int, PuzzleEntry>& entries()
+	{
+		static std::map<int, PuzzleEntry> entries;
+		return entries;
+	}
+};
+
+template <int Day, typename T>
+struct Registration
+{
+	static_assert(Day >= 1 && Day <= 25, "Advent of Code has 25 days");
+	static_assert(std::is_base_of_v<Puzzle, T>);
+
+	// Pass __DATE__ " " __TIME__, so the id is that of the day's own translation unit
+	explicit Registration(char const* const buildId)
+	{
+		Registry::entries()[Day] = {
+			[]() -> std::unique_ptr<Puzzle> { return std::make_unique<T>(); }, &staticPartOne<T>, &staticPartTwo<T>,
+			&T::generate, accumulatorFor<T>(), buildId
+		};
+	}
+};
+
+inline std::unique_ptr<Puzzle> getPuzzle(int const day)
+{
+	auto const entry = Registry::find(day);
+	return entry ? entry->create() : nullptr;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "utils.h"
+
+// 64 bit FNV-1a
+inline uint64_t hashBytes(std::string_view const bytes, uint64_t hash = 14695981039346656037ull)
+{
+	for (auto const byte : bytes)
+	{
+		hash ^= static_cast<unsigned char>(byte);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// What a cached result depends on. The build id changes whenever the day's code is compiled again.
+struct ResultKey
+{
+	int day;
+	uint64_t inputHash;
+	std::string_view buildId;
+	Parameters const& parameters;
+};
+
+// Results on disk, one small file per day, input and build: a line "<part> <result>" for each part that ran.
+// Unchanged inputs then don't have to be solved again.
+class ResultCache
+{
+public:
+	explicit ResultCache(std::filesystem::path directory = ".aoccache") :
+		directory(std::move(directory))
+	{
+	}
+
+	std::optional<long long> find(ResultKey const& key, int const part) const
+	{
+		std::ifstream file{pathFor(key)};
+		int storedPart;
+		long long result;
+		while (file >> storedPart >> result)
+			if (storedPart == part)
+				return result;
+		return std::nullopt;
+	}
+
+	void store(ResultKey const& key, int const part, long long const result) const
+	{
+		auto const path = pathFor(key);
+		std::string contents;
+		{
+			std::ifstream file{path};
+			int storedPart;
+			long long storedResult;
+			while (file >> storedPart >> storedResult)
+				if (storedPart != part)
+					contents += std::format("{} {}\n", storedPart, storedResult);
+		}
+		contents += std::format("{} {}\n", part, result);
+
+		// Written next to it and renamed, so a reader never sees half a file
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		auto temporary = path;
+		temporary += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			std::ofstream file{temporary, std::ios::trunc};
+			file << contents;
+			if (!file)
+				return;
+		}
+		std::filesystem::rename(temporary, path, error);
+	}
+
+	void clear() const
+	{
+		std::error_code error;
+		std::filesystem::remove_all(directory, error);
+	}
+
+private:
+	std::filesystem::path pathFor(ResultKey const& key) const
+	{
+		auto buildHash = hashBytes(key.buildId);
+		for (auto const& [name, value] : key.parameters)
+			buildHash = hashBytes(std::format("{}={};", name, value), buildHash);
+		return directory / std::format("{}-{:016x}-{:016x}.txt", key.day, key.inputHash, buildHash);
+	}
+
+	std::filesystem::path directory;
+};
@@ -0,0 +1,345 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+#include "AllocationTracker.h"
+#include "Input.h"
+#include "Registry.h"
+#include "ResultCache.h"
+#include "ThreadPool.h"
+
+// CPU time used by the calling thread. Days that parallelise internally (six uses std::execution) spend CPU on
+// other threads as well, that time is not included.
+inline std::chrono::nanoseconds threadCpuTime()
+{
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+	GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+	auto const toTicks = [](FILETIME const& time)
+	{
+		return (static_cast<long long>(time.dwHighDateTime) << 32) + time.dwLowDateTime;
+	};
+	return std::chrono::nanoseconds((toTicks(kernel) + toTicks(user)) * 100);
+#else
+	timespec time{};
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+struct Timing
+{
+	std::chrono::nanoseconds wall{};
+	std::chrono::nanoseconds cpu{};
+};
+
+class Stopwatch
+{
+public:
+	Timing elapsed() const
+	{
+		return {std::chrono::steady_clock::now() - wallStart, threadCpuTime() - cpuStart};
+	}
+
+private:
+	std::chrono::steady_clock::time_point wallStart{std::chrono::steady_clock::now()};
+	std::chrono::nanoseconds cpuStart{threadCpuTime()};
+};
+
+template <typename Function>
+auto timed(Timing& timing, Function&& function)
+{
+	Stopwatch const stopwatch;
+	auto result = function();
+	timing = stopwatch.elapsed();
+	return result;
+}
+
+// Everything measured while a day loads its inputs or runs a part
+struct Phase
+{
+	Timing timing;
+	InstrumentationReport metrics; // only with AOC_INSTRUMENT
+	AllocationStats allocations; // only with AOC_TRACK_ALLOCATIONS
+	bool cached{false}; // the result came from the ResultCache, nothing ran
+};
+
+template <typename Function>
+auto measured(Phase& phase, Function&& function)
+{
+	Instrumentation::take();
+	AllocationTracker::begin();
+	auto result = timed(phase.timing, function);
+	phase.allocations = AllocationTracker::end();
+	phase.metrics = Instrumentation::take();
+	return result;
+}
+
+struct DayReport
+{
+	int day{0};
+	Results results{};
+	Phase load;
+	Phase samplePartOne;
+	Phase samplePartTwo;
+	Phase partOne;
+	Phase partTwo;
+	std::string error;
+
+	AllocationStats totalAllocations() const
+	{
+		AllocationStats total;
+		for (auto const phase : {&load, &samplePartOne, &samplePartTwo, &partOne, &partTwo})
+		{
+			total.count += phase->allocations.count;
+			total.bytes += phase->allocations.bytes;
+			total.peak = (std::max)(total.peak, phase->allocations.peak);
+		}
+		return total;
+	}
+};
+
+inline DayReport runDay(int const day, RunMode const& mode)
+{
+	DayReport report;
+	report.day = day;
+	try
+	{
+		auto const entry = Registry::find(day);
+		if (!entry)
+		{
+			report.error = "no such day";
+			return report;
+		}
+		auto const puzzle = entry->create();
+		puzzle->configure(mode);
+
+		measured(report.load, [&]
+		{
+			if (mode.sample)
+				puzzle->getSample();
+			if (mode.real)
+				puzzle->getTest();
+			return 0;
+		});
+
+		// Hashing reads every byte of the inputs, so it is left out of the load time and skipped without the cache
+		uint64_t sampleHash = 0;
+		uint64_t testHash = 0;
+		if (mode.cache && mode.sample)
+			sampleHash = hashBytes(puzzle->getSample().buffer);
+		if (mode.cache && mode.real)
+			testHash = hashBytes(puzzle->getTest().buffer);
+
+		// Parts with a cached result for these inputs don't run
+		ResultCache const cache;
+		auto const keyFor = [&](int const index)
+		{
+			return ResultKey{day, index < 2 ? sampleHash : testHash, entry->buildId, mode.parameters};
+		};
+		auto const partNumber = [](int const index) { return index % 2 + 1; };
+		auto const useCache = [&](int const index) { return mode.cache && puzzle->cacheable(partNumber(index)); };
+		std::array const phases{&report.samplePartOne, &report.samplePartTwo, &report.partOne, &report.partTwo};
+		auto enabled = Puzzle::enabledParts(mode);
+		Results cached;
+		for (auto const index : range(enabled.size()))
+		{
+			if (!enabled[index] || !useCache(index))
+				continue;
+			cached.at(index) = cache.find(keyFor(index), partNumber(index));
+			phases[index]->cached = cached.at(index).has_value();
+			enabled[index] = !phases[index]->cached;
+		}
+
+		// Every part is measured on the thread that runs it
+		report.results = puzzle->runParts(enabled, [&](int const index, auto const& part)
+		{
+			return measured(*phases[index], part);
+		});
+
+		for (auto const index : range(enabled.size()))
+		{
+			if (phases[index]->cached)
+				report.results.at(index) = cached.at(index);
+			else if (enabled[index] && useCache(index))
+				cache.store(keyFor(index), partNumber(index), *report.results.at(index));
+		}
+	}
+	catch (std::exception const& exception)
+	{
+		report.error = exception.what();
+	}
+	return report;
+}
+
+inline std::string formatAllocations(AllocationStats const& allocations)
+{
+	return std::format("{} allocations, {} bytes, peak {} bytes", allocations.count, allocations.bytes,
+	                   allocations.peak);
+}
+
+inline void printReport(DayReport const& report)
+{
+	auto const milliseconds = [](std::chrono::nanoseconds const duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+	auto const printPhase = [&](std::string const& name, Phase const& phase, std::string const& result)
+	{
+		std::cout << std::format("{:>4}  {:<18}{:>12.3f}{:>12.3f}  {}{}\n", report.day, name,
+		                         milliseconds(phase.timing.wall), milliseconds(phase.timing.cpu), result,
+		                         phase.cached ? " (cached)" : "");
+		if constexpr (allocationTrackingEnabled)
+			std::cout << std::format("{:>4}    {}\n", report.day, formatAllocations(phase.allocations));
+		for (auto const& [metric, value] : phase.metrics.counters)
+			std::cout << std::format("{:>4}    {:<34}{:>16}\n", report.day, metric, value);
+		for (auto const& [metric, value] : phase.metrics.gauges)
+			std::cout << std::format("{:>4}    {:<34}{:>16}  peak\n", report.day, metric, value);
+		for (auto const& [metric, value] : phase.metrics.timers)
+			std::cout << std::format("{:>4}    {:<34}{:>16.3f}  ms\n", report.day, metric, milliseconds(value));
+	};
+	auto const printPart = [&](std::string const& name, Phase const& phase, std::optional<long long> const& result)
+	{
+		if (result)
+			printPhase(name, phase, std::to_string(*result));
+	};
+
+	if (!report.error.empty())
+	{
+		std::cout << std::format("{:>4}  failed: {}\n", report.day, report.error);
+		return;
+	}
+
+	printPhase("input load", report.load, "");
+	printPart("sample part one", report.samplePartOne, report.results.samplePartOne);
+	printPart("sample part two", report.samplePartTwo, report.results.samplePartTwo);
+	printPart("part one", report.partOne, report.results.partOne);
+	printPart("part two", report.partTwo, report.results.partTwo);
+}
+
+// Runs all days at once on the pool and prints a timing table once every day has finished.
+inline void runBatch(std::vector<int> const& days, RunMode const& mode, unsigned const numThreads)
+{
+	std::vector<DayReport> reports;
+	Stopwatch const stopwatch;
+	{
+		ThreadPool pool{numThreads};
+		std::vector<std::future<DayReport>> futures;
+		for (auto const day : days)
+			futures.push_back(pool.submit([day, mode] { return runDay(day, mode); }));
+		for (auto& future : futures)
+			reports.push_back(future.get());
+	}
+	auto const total = stopwatch.elapsed();
+
+	std::cout << std::format("\n{:>4}  {:<18}{:>12}{:>12}  {}\n", "Day", "Phase", "Wall (ms)", "CPU (ms)", "Result");
+	for (auto const& report : reports)
+		printReport(report);
+	std::cout << std::format("\n{} days in {:.3f} ms\n", days.size(),
+	                         std::chrono::duration<double, std::milli>(total.wall).count());
+
+	if constexpr (allocationTrackingEnabled)
+	{
+		std::ranges::sort(reports, std::greater{}, [](DayReport const& report) { return report.totalAllocations().bytes; });
+		std::cout << "\nDays by bytes allocated\n";
+		for (auto const& report : reports)
+			std::cout << std::format("{:>4}  {}\n", report.day, formatAllocations(report.totalAllocations()));
+	}
+}
+
+// Feeds a stream line by line to the day's accumulator, so memory stays the same whatever the size of the input.
+// Returns false when the day can't stream.
+inline bool runStream(int const day, RunMode const& mode, std::istream& in)
+{
+	auto const entry = Registry::find(day);
+	if (!entry || !entry->createAccumulator)
+	{
+		std::cout << std::format("Day {} can't stream its input\n", day);
+		return false;
+	}
+
+	auto const puzzle = entry->create();
+	puzzle->configure(mode);
+	auto const accumulator = entry->createAccumulator(*puzzle);
+	LineStream lines{in};
+	Timing timing;
+	timed(timing, [&]
+	{
+		lines.forEachLine([&](std::string_view const line) { accumulator->add(line); });
+		return 0;
+	});
+
+	auto const printPart = [&](std::string const& part, std::optional<long long> const& result)
+	{
+		std::cout << std::format("{:>4}  {:<10}{}\n", day, part, result ? std::to_string(*result) : "not streamable");
+	};
+	if (mode.partOne)
+		printPart("part one", accumulator->partOne());
+	if (mode.partTwo)
+		printPart("part two", accumulator->partTwo());
+	std::cout << std::format("{} lines in {:.3f} ms\n", lines.numLines(),
+	                         std::chrono::duration<double, std::milli>(timing.wall).count());
+	return true;
+}
+
+// A command line value that is a whole number (or decimal for floating point T) in [minimum, maximum]. Anything else,
+// like "x", "4x" or "0" for a minimum of 1, throws with a message naming the value.
+template <typename T>
+T parseArgument(std::string_view const name, std::string_view const text, T const minimum,
+                T const maximum = (std::numeric_limits<T>::max)())
+{
+	T value{};
+	auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+	if (error == std::errc{} && end == text.data() + text.size() && value >= minimum && value <= maximum)
+		return value;
+
+	if (maximum == (std::numeric_limits<T>::max)())
+		throw std::invalid_argument(std::format("{} must be a number of at least {}, got \"{}\"", name, minimum, text));
+	throw std::invalid_argument(
+		std::format("{} must be a number from {} to {}, got \"{}\"", name, minimum, maximum, text));
+}
+
+// The day, if it has a puzzle (see --list)
+inline int registeredDay(int const day)
+{
+	if (!Registry::find(day))
+		throw std::invalid_argument(std::format("there is no puzzle for day {} (yet)", day));
+	return day;
+}
+
+// Accepts day numbers, ranges like 3-7 and "all"
+inline std::vector<int> parseDays(std::vector<std::string> const& arguments)
+{
+	std::vector<int> days;
+	for (auto const& argument : arguments)
+	{
+		if (argument == "all")
+		{
+			auto const all = Registry::days();
+			days.insert(days.end(), all.begin(), all.end());
+			continue;
+		}
+
+		auto const bounds = split(argument, "-");
+		auto bound = bounds.begin();
+		auto const first = parseArgument("day", *bound, 1, 25);
+		auto const last = ++bound != bounds.end() ? parseArgument("day", *bound, first, 25) : first;
+		for (auto const day : range(first, last + 1))
+			days.push_back(registeredDay(day));
+	}
+	return days;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Incremental solver for days whose records can be handled one at a time. Lines are fed in order and are only valid
+// during the call, so an accumulator keeps what it needs and nothing more. A part that needs the whole input at once
+// returns nullopt.
+class Accumulator
+{
+public:
+	virtual ~Accumulator() = default;
+
+	virtual void add(std::string_view line) = 0;
+	virtual std::optional<long long> partOne() const = 0;
+	virtual std::optional<long long> partTwo() const = 0;
+};
+
+// Reads a stream in fixed size chunks and hands out its lines, so memory use doesn't depend on the input size.
+// Lines are split like Input does: a trailing '\r' is dropped and a final newline doesn't give an extra empty line.
+class LineStream
+{
+public:
+	explicit LineStream(std::istream& in, size_t const chunkSize = 1 << 20) :
+		in(in),
+		buffer(chunkSize, '\0')
+	{
+	}
+
+	template <typename Consume>
+	void forEachLine(Consume&& consume)
+	{
+		size_t kept = 0; // start of an unfinished line, moved to the front of the buffer
+		while (in)
+		{
+			if (kept == buffer.size())
+				buffer.resize(2 * buffer.size()); // a single line longer than the buffer
+
+			in.read(buffer.data() + kept, static_cast<std::streamsize>(buffer.size() - kept));
+			auto const filled = kept + static_cast<size_t>(in.gcount());
+			std::string_view const chunk{buffer.data(), filled};
+
+			size_t start = 0;
+			for (auto end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n', start))
+			{
+				emit(chunk.substr(start, end - start), consume);
+				start = end + 1;
+			}
+
+			kept = filled - start;
+			std::memmove(buffer.data(), buffer.data() + start, kept);
+		}
+
+		if (kept > 0)
+			emit({buffer.data(), kept}, consume);
+	}
+
+	size_t numLines() const
+	{
+		return lines;
+	}
+
+private:
+	template <typename Consume>
+	void emit(std::string_view line, Consume& consume)
+	{
+		if (line.ends_with('\r'))
+			line.remove_suffix(1);
+		++lines;
+		consume(line);
+	}
+
+	std::istream& in;
+	std::string buffer;
+	size_t lines{0};
+};
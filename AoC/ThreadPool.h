@@ -0,0 +1,189 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+// Work stealing thread pool. Every worker owns a queue: it takes work from the back of its own queue and steals
+// from the front of the others when it runs dry. Tasks submitted from inside a worker stay on that worker's queue,
+// so nested work (a day that splits itself up) is picked up by the same thread first.
+class ThreadPool
+{
+public:
+	explicit ThreadPool(unsigned const numThreads = (std::max)(1u, std::thread::hardware_concurrency()))
+	{
+		assert(numThreads > 0);
+		for ([[maybe_unused]] auto _ : std::views::iota(0u, numThreads))
+			queues.push_back(std::make_unique<Queue>());
+
+		for (auto const index : std::views::iota(0u, numThreads))
+			threads.emplace_back([this, index] { work(index); });
+	}
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard lock(sleepMutex);
+			stopping = true;
+		}
+		wakeUp.notify_all();
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	template <typename Function>
+	auto submit(Function&& function)
+	{
+		using Result = std::invoke_result_t<Function>;
+		std::packaged_task<Result()> task{std::forward<Function>(function)};
+		auto future = task.get_future();
+		push([task = std::move(task)]() mutable { task(); });
+		return future;
+	}
+
+	// Waits for the future while running queued tasks on the calling thread. Waiting from inside a task must go
+	// through here, otherwise all workers can end up blocked on work that is still sitting in a queue. With nothing to
+	// run the caller sleeps until a task is queued or one finishes, which may be the one it waits for.
+	template <typename T>
+	T wait(std::future<T>& future)
+	{
+		auto const ready = [&] { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+		while (!ready())
+		{
+			if (runPendingTask())
+				continue;
+
+			std::unique_lock lock(sleepMutex);
+			++waiting;
+			// The timeout only matters for futures that don't come from this pool
+			wakeUp.wait_for(lock, std::chrono::milliseconds(10), [&] { return pending > 0 || ready(); });
+			--waiting;
+		}
+		return future.get();
+	}
+
+	unsigned size() const
+	{
+		return static_cast<unsigned>(threads.size());
+	}
+
+	// The pool the calling thread works for, if any
+	static ThreadPool* current()
+	{
+		return currentPool;
+	}
+
+private:
+	using Task = std::move_only_function<void()>;
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void push(Task task)
+	{
+		auto const index = currentPool == this ? currentIndex : nextQueue++ % queues.size();
+		// Counted before it can be taken, so a thread that takes it straight away can't take pending below 0
+		{
+			std::lock_guard lock(sleepMutex);
+			++pending;
+		}
+		{
+			std::lock_guard lock(queues[index]->mutex);
+			queues[index]->tasks.push_back(std::move(task));
+		}
+		wakeUp.notify_one();
+	}
+
+	std::optional<Task> pop(size_t const index)
+	{
+		// Own queue first, newest task first
+		auto const own = currentPool == this ? currentIndex : index;
+		{
+			auto& queue = *queues[own];
+			std::lock_guard lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				auto task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				--pending;
+				return task;
+			}
+		}
+
+		// Steal the oldest task from someone else
+		for (auto const offset : std::views::iota(size_t{1}, queues.size()))
+		{
+			auto& queue = *queues[(own + offset) % queues.size()];
+			std::lock_guard lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				auto task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				--pending;
+				return task;
+			}
+		}
+		return std::nullopt;
+	}
+
+	bool runPendingTask()
+	{
+		auto task = pop(0);
+		if (!task)
+			return false;
+		(*task)();
+		if (waiting > 0)
+		{
+			// Taking the lock makes sure a waiter either saw the result or is asleep and gets the notification
+			{
+				std::lock_guard lock(sleepMutex);
+			}
+			wakeUp.notify_all();
+		}
+		return true;
+	}
+
+	void work(size_t const index)
+	{
+		currentPool = this;
+		currentIndex = index;
+		while (true)
+		{
+			if (runPendingTask())
+				continue;
+
+			std::unique_lock lock(sleepMutex);
+			wakeUp.wait(lock, [this] { return stopping || pending > 0; });
+			if (stopping && pending == 0)
+				return;
+		}
+	}
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> threads;
+	std::atomic<size_t> nextQueue{0};
+	std::atomic<size_t> pending{0};
+	std::atomic<size_t> waiting{0}; // callers of wait that are asleep
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	bool stopping{false};
+
+	static inline thread_local ThreadPool* currentPool{nullptr};
+	static inline thread_local size_t currentIndex{0};
+};
@@ -0,0 +1,4 @@
+#include "t.h"
+#include "Registry.h"
+
+static Registration<0, ...> const registration{__DATE__ " " __TIME__};
@@ -9,6 +9,11 @@ public:
 	{
 	}
 
+	// Writes an input of about generator.size() lines, cells or bytes
+	static void generate(Generator& generator)
+	{
+	}
+
 	long long partOne(const Input& input) override
 	{
 		if (input.lines.empty())
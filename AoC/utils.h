@@ -1,53 +1,211 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <climits>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <format>
+#include <functional>
+#include <future>
+#include <iostream>
 #include <map>
+#include <memory>
+#include <numeric>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <ranges>
 #include <unordered_map>
-#include <rpc.h>
+#include <unordered_set>
+#include <utility>
 #include <set>
 
-inline GUID newGuid()
-{
-	GUID guid;
-	UuidCreate(&guid);
-	return guid;
-}
+#include "FrameRenderer.h"
+#include "ThreadPool.h"
 
-struct GUIDComparator
+using Parameters = std::map<std::string, long long>;
+
+// The pieces of a text between delimiters, leaving out empty ones. Found while iterating and pointing into the text,
+// so nothing is copied or allocated.
+class SplitView : public std::ranges::view_interface<SplitView>
 {
-	bool operator()(const GUID& lhs, const GUID& rhs) const
+public:
+	class Iterator
 	{
-		return memcmp(&lhs, &rhs, sizeof(GUID)) < 0;
+	public:
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+
+		Iterator(std::string_view const text, std::string_view const delimiter) :
+			rest(text),
+			delimiter(delimiter)
+		{
+			advance();
+		}
+
+		std::string_view operator*() const
+		{
+			return token;
+		}
+
+		Iterator& operator++()
+		{
+			advance();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto const copy = *this;
+			advance();
+			return copy;
+		}
+
+		bool operator==(std::default_sentinel_t) const
+		{
+			return atEnd;
+		}
+
+		bool operator==(Iterator const& other) const
+		{
+			return atEnd == other.atEnd && (atEnd || token.data() == other.token.data());
+		}
+
+	private:
+		void advance()
+		{
+			atEnd = true;
+			while (!rest.empty())
+			{
+				auto const end = rest.find(delimiter);
+				token = rest.substr(0, end);
+				rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + delimiter.size());
+				if (!token.empty())
+				{
+					atEnd = false;
+					return;
+				}
+			}
+		}
+
+		std::string_view rest;
+		std::string_view delimiter;
+		std::string_view token;
+		bool atEnd{true};
+	};
+
+	SplitView() = default;
+
+	SplitView(std::string_view const text, std::string_view const delimiter) :
+		text(text),
+		delimiter(delimiter)
+	{
+		assert(!delimiter.empty());
 	}
-};
 
-template <class T>
-using GuidMap = std::map<GUID, T, GUIDComparator>;
+	Iterator begin() const
+	{
+		return {text, delimiter};
+	}
 
-using GuidSet = std::set<GUID, GUIDComparator>;
+	std::default_sentinel_t end() const
+	{
+		return {};
+	}
 
+private:
+	std::string_view text;
+	std::string_view delimiter;
+};
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<SplitView> = true;
 
-inline std::vector<std::string> split(std::string const& text, std::string const& delimiter)
+inline SplitView split(std::string_view const text, std::string_view const delimiter)
 {
-	std::vector<std::string> result;
+	return {text, delimiter};
+}
 
-	int start = 0;
-	auto end = text.find(delimiter);
-	while (end != std::string::npos)
+// Pulls the integers out of a line or a whole input, whatever separates them ("p=", "X+", ", ", newlines...). A '-'
+// right in front of a digit makes the number negative. Nothing is allocated.
+class NumberScanner
+{
+public:
+	explicit NumberScanner(std::string_view const text) :
+		text(text)
 	{
-		auto const found = text.substr(start, end - start);
-		if (!found.empty())
-			result.push_back(found);
-		start = end + delimiter.size();
-		end = text.find(delimiter, start);
 	}
-	auto const rest = text.substr(start, end - start);
-	if (!rest.empty())
-		result.push_back(text.substr(start, end - start));
 
+	// The next number, nullopt once there are none left
+	template <std::integral T = long long>
+	std::optional<T> next()
+	{
+		auto const isDigit = [](char const ch) { return ch >= '0' && ch <= '9'; };
+		while (position < text.size() && !isDigit(text[position]) &&
+			!(text[position] == '-' && position + 1 < text.size() && isDigit(text[position + 1])))
+			++position;
+		if (position == text.size())
+			return std::nullopt;
+
+		T value{};
+		auto const begin = text.data() + position;
+		auto const [end, error] = std::from_chars(begin, text.data() + text.size(), value);
+		if (error != std::errc{})
+			throw std::out_of_range(std::format("number too large: {}", text.substr(position, 20)));
+		position += end - begin;
+		return value;
+	}
+
+	// The next number of an input that is known to have one
+	template <std::integral T = long long>
+	T get()
+	{
+		auto const value = next<T>();
+		if (!value)
+			throw std::runtime_error(std::format("expected another number in: {}", text.substr(0, 80)));
+		return *value;
+	}
+
+private:
+	std::string_view text;
+	size_t position{0};
+};
+
+// All numbers in the text
+template <std::integral T = long long>
+std::vector<T> scanNumbers(std::string_view const text)
+{
+	std::vector<T> result;
+	NumberScanner scanner{text};
+	while (auto const value = scanner.next<T>())
+		result.push_back(*value);
+	return result;
+}
+
+// The first N numbers in the text, for lines with a fixed layout: auto const [x, y] = scanNumbers<2>(line);
+template <size_t N, std::integral T = long long>
+std::array<T, N> scanNumbers(std::string_view const text)
+{
+	std::array<T, N> result;
+	NumberScanner scanner{text};
+	for (auto& value : result)
+		value = scanner.get<T>();
 	return result;
 }
 
@@ -61,45 +219,95 @@ auto range(auto const start, auto const bound)
 	return std::ranges::iota_view(static_cast<int>(start), static_cast<int>(bound));
 }
 
-class Location : public std::pair<long long, long long>
+// Held while logging so parts running at the same time don't mix their output
+inline std::mutex& drawMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+// How much solvers write to the console, fixed at compile time so that disabled output costs nothing. Define
+// AOC_VERBOSITY to one of the levels, by default release builds only print answers that can't be returned as a
+// number and debug builds add progress information. Drawings are only made at Render.
+enum class Verbosity
+{
+	Quiet,
+	Answer,
+	Info,
+	Trace,
+	Render,
+};
+
+#ifdef AOC_VERBOSITY
+inline constexpr auto verbosity = static_cast<Verbosity>(AOC_VERBOSITY);
+#elif defined(NDEBUG)
+inline constexpr auto verbosity = Verbosity::Answer;
+#else
+inline constexpr auto verbosity = Verbosity::Info;
+#endif
+
+template <Verbosity Level, typename... Args>
+void log(std::format_string<Args...> const format, Args&&... args)
+{
+	if constexpr (Level <= verbosity)
+	{
+		std::lock_guard lock(drawMutex());
+		std::cout << std::format(format, std::forward<Args>(args)...);
+	}
+}
+
+// Calls draw only when the level is enabled, draw must not log
+template <Verbosity Level = Verbosity::Render, typename Draw>
+void render(Draw&& draw)
+{
+	if constexpr (Level <= verbosity)
+		draw();
+}
+
+// A y, x pair: first is y and second is x. Location keeps them in 32 bits each, so it is 8 bytes and hashes as a single
+// 64 bit key. WideLocation is for coordinates that don't fit, like the claw positions of day 13.
+template <std::signed_integral T>
+class BasicLocation
 {
 public:
-	Location() = default;
+	constexpr BasicLocation() = default;
+
+	constexpr BasicLocation(long long const y, long long const x) :
+		first(static_cast<T>(y)),
+		second(static_cast<T>(x))
+	{
+	}
 
-	Location(long long y, long long x) :
-		std::pair<long long, long long>(y, x)
+	[[nodiscard]] constexpr BasicLocation move(BasicLocation const dLocation, long long const num = 1) const
 	{
+		return {first + num * dLocation.first, second + num * dLocation.second};
 	}
 
-	[[nodiscard]] Location move(Location const dLocation, long long num = 1) const
+	[[nodiscard]] constexpr BasicLocation moveBack(BasicLocation const dLocation) const
 	{
-		auto move = *this;
-		move.first += num * dLocation.first;
-		move.second += num * dLocation.second;
-		return move;
+		return {first - dLocation.first, second - dLocation.second};
 	}
 
-	[[nodiscard]] Location moveBack(Location const dLocation) const
+	[[nodiscard]] constexpr long long getDistanceSquared(BasicLocation const& other) const
 	{
-		auto move = *this;
-		move.first -= dLocation.first;
-		move.second -= dLocation.second;
-		return move;
+		auto const dx = x() - other.x();
+		auto const dy = y() - other.y();
+		return dx * dx + dy * dy;
 	}
 
-	[[nodiscard]] long long getDistanceSquared(Location const& other) const
+	[[nodiscard]] double getDistance(BasicLocation const& other) const
 	{
-		auto const dx = std::abs(x() - other.x());
-		auto const dy = std::abs(y() - other.y());
-		return static_cast<long long>(std::pow(dx, 2)) + static_cast<long long>(std::pow(dy, 2));
+		return std::sqrt(static_cast<double>(getDistanceSquared(other)));
 	}
 
-	[[nodiscard]] long long getManhattenDistance(Location const& other) const
+	[[nodiscard]] constexpr long long getManhattenDistance(BasicLocation const& other) const
 	{
-		return std::abs(other.x() - x()) + std::abs(other.y() - y());
+		auto const dx = other.x() - x();
+		auto const dy = other.y() - y();
+		return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
 	}
 
-	[[nodiscard]] double getDirection(Location const& other) const
+	[[nodiscard]] constexpr double getDirection(BasicLocation const& other) const
 	{
 		long long const dx = other.x() - x();
 		long long const dy = other.y() - y();
@@ -108,267 +316,538 @@ public:
 		return static_cast<double>(dy) / static_cast<double>(dx);
 	}
 
-	[[nodiscard]] long long y() const
+	[[nodiscard]] constexpr long long y() const
 	{
 		return first;
 	}
 
-	[[nodiscard]] long long x() const
+	[[nodiscard]] constexpr long long x() const
 	{
 		return second;
 	}
+
+	// Both coordinates in one number, y in the high half, for hashing
+	[[nodiscard]] constexpr uint64_t key() const
+		requires (sizeof(T) <= 4)
+	{
+		return static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32 | static_cast<uint32_t>(second);
+	}
+
+	constexpr auto operator<=>(BasicLocation const&) const = default;
+
+	T first{};
+	T second{};
+};
+
+using Location = BasicLocation<int32_t>;
+using WideLocation = BasicLocation<long long>;
+
+// splitmix64's finaliser: every bit of the key affects every bit of the hash, so nearby cells don't collide in buckets
+constexpr uint64_t mixBits(uint64_t value)
+{
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+	return value ^ (value >> 31);
+}
+
+template <typename T>
+struct std::hash<BasicLocation<T>>
+{
+	size_t operator()(BasicLocation<T> const& location) const
+	{
+		if constexpr (sizeof(T) <= 4)
+			return static_cast<size_t>(mixBits(location.key()));
+		else
+			return static_cast<size_t>(mixBits(mixBits(static_cast<uint64_t>(location.first)) ^
+				static_cast<uint64_t>(location.second)));
+	}
+};
+
+// Steps to the cells around a cell: up, down, right and left, then the diagonals
+inline constexpr std::array<Location, 4> orthogonalMoves{{{-1, 0}, {1, 0}, {0, 1}, {0, -1}}};
+inline constexpr std::array<Location, 4> diagonalMoves{{{-1, -1}, {-1, 1}, {1, 1}, {1, -1}}};
+inline constexpr std::array<Location, 8> allMoves{
+	{{-1, 0}, {1, 0}, {0, 1}, {0, -1}, {-1, -1}, {-1, 1}, {1, 1}, {1, -1}}
 };
 
-class Coordinate
+// The characters of a Grid seen mirrored or turned, without copying them: a cell is found from where the first one is
+// and how far apart rows and columns are, which is negative when they run backwards. Transforms give another view, so
+// they can be chained for free. The grid has to outlive its views.
+class GridView
 {
 public:
-	Coordinate() = default;
-	Coordinate(std::string const& value, int x, int y, bool convertToInt):
-		location({y, x}),
-		strValue(value),
-		intValue(convertToInt ? std::stoi(value) : -1)
+	GridView(char const* const cells, int const yMax, int const xMax, int const rowStride) :
+		cells(cells),
+		width(xMax),
+		height(yMax),
+		rowStride(rowStride)
 	{
 	}
 
-	int y() const
+	char get(int const y, int const x) const
 	{
-		return location.y();
+		assert(y >= 0 && y < height && x >= 0 && x < width);
+		return cells[origin + y * rowStride + x * columnStride];
 	}
 
-	int x() const
+	char get(Location const& location) const
 	{
-		return location.x();
+		return get(static_cast<int>(location.y()), static_cast<int>(location.x()));
 	}
 
-	double getDirection(Coordinate const& other) const
+	GridView mirrorVertical() const
 	{
-		return location.getDirection(other.location);
+		auto mirrored = *this;
+		mirrored.origin += (width - 1) * columnStride;
+		mirrored.columnStride = -columnStride;
+		return mirrored;
 	}
 
-	int getDistanceSquared(Coordinate const& other) const
+	GridView mirrorHorizontal() const
 	{
-		return location.getDistanceSquared(other.location);
+		auto mirrored = *this;
+		mirrored.origin += (height - 1) * rowStride;
+		mirrored.rowStride = -rowStride;
+		return mirrored;
 	}
 
-	double getDistance(Coordinate const& other) const
+	// Turned a quarter counterclockwise, so the last column becomes the first row
+	GridView transpose() const
 	{
-		return std::sqrt(getDistanceSquared(other));
+		auto turned = *this;
+		std::swap(turned.width, turned.height);
+		turned.origin += (width - 1) * columnStride;
+		turned.rowStride = -columnStride;
+		turned.columnStride = rowStride;
+		return turned;
 	}
 
-	Location location;
-	std::string strValue;
-	int intValue;
+	int xMax() const
+	{
+		return width;
+	}
+
+	int yMax() const
+	{
+		return height;
+	}
+
+private:
+	char const* cells;
+	int width;
+	int height;
+	std::ptrdiff_t origin{0};
+	std::ptrdiff_t rowStride;
+	std::ptrdiff_t columnStride{1};
 };
 
+// Row-major grid of one character per cell, with an int per cell next to it for grids of digits. Locations are worked
+// out from the position in the grid rather than stored.
+// Given a border, the grid is framed by a row and column of that character on every side, which get and value can read
+// at -1, xMax and yMax (the int there is -1). Loops can then look at the neighbours of any cell without bounds checks.
 class Grid
 {
 public:
-	Grid(std::vector<std::string> const& input, bool const convertToInt)
+	Grid(std::ranges::sized_range auto const& input, bool const convertToInt,
+	     std::optional<char> const border = std::nullopt) :
+		width(std::ranges::empty(input) ? 0 : static_cast<int>(std::ranges::begin(input)->size())),
+		height(static_cast<int>(input.size())),
+		padding(border ? 1 : 0),
+		cells(static_cast<size_t>(stride()) * (height + 2 * padding), border.value_or('\0'))
 	{
-		data.resize(input.size());
-
 		int y = 0;
 		for (auto const& line : input)
 		{
-			data[y].resize(line.size());
-			int x = 0;
-			for (auto const& ch : line)
-			{
-				data[y][x] = Coordinate{std::string{ch}, x, y, convertToInt};
-				++x;
-			}
-			++y;
+			if (static_cast<int>(line.size()) != width)
+				throw std::invalid_argument(
+					std::format("grid line {} is {} characters wide, the first is {}", y, line.size(), width));
+			std::ranges::copy(line, cells.begin() + index(y++, 0));
+		}
+
+		if (convertToInt)
+		{
+			values.assign(cells.size(), -1);
+			for (auto const location : locations())
+				values[index(location)] = get(location) - '0';
 		}
 	}
 
+	Grid(int const yMax, int const xMax, char const fill, std::optional<char> const border = std::nullopt) :
+		width(xMax),
+		height(yMax),
+		padding(border ? 1 : 0),
+		cells(static_cast<size_t>(stride()) * (height + 2 * padding), border.value_or(fill))
+	{
+		if (border)
+			for (auto const y : range(height))
+				std::fill_n(cells.begin() + index(y, 0), width, fill);
+	}
+
 	void draw() const
 	{
-		static int previousLines = 0; // Track the number of lines previously drawn
-		int currentLines = data.size() + 2; // Calculate lines this draw will use
-		static std::unordered_map<std::string, int> colorMap; // Map characters to colors
-		static int colorIndex = 1; // Start assigning colors from 1
+		FrameRenderer::instance().draw(height, width, [this](int const y, int const x) { return get(y, x); });
+	}
 
-		// Hide the cursor
-		std::cout << "\033[?25l";
+	char& get(int const y, int const x)
+	{
+		return cells[index(y, x)];
+	}
 
-		// Move the cursor up by the number of lines previously drawn
-		if (previousLines > 0)
-			std::cout << "\033[" << previousLines << "A"; // Move cursor up
+	char& get(Location const& location)
+	{
+		return cells[index(location)];
+	}
 
-		std::cout << "\n";
-		for (auto const& line : data)
-		{
-			for (auto const& coordinate : line)
-			{
-				// Get the string to print
-				std::string value = (coordinate.intValue > -1)
-					                    ? std::to_string(coordinate.intValue)
-					                    : coordinate.strValue;
+	char get(int const y, int const x) const
+	{
+		return cells[index(y, x)];
+	}
 
-				// Assign a color if not already assigned
-				if (!colorMap.contains(value))
-					colorMap[value] = 31 + (colorIndex++ % 6); // Cycle through 6 colors (3136)
+	char get(Location const& location) const
+	{
+		return cells[index(location)];
+	}
 
-				// Print the value with its assigned color
-				std::cout << "\033[" << colorMap[value] << "m" << value << "\033[0m"; // Reset color after printing
-			}
-			std::cout << "\n";
-		}
-		std::cout << "\n";
+	// Only for grids made with convertToInt
+	int value(int const y, int const x) const
+	{
+		return values[index(y, x)];
+	}
 
-		// Update the count of previously drawn lines
-		previousLines = currentLines;
+	int value(Location const& location) const
+	{
+		return values[index(location)];
+	}
 
-		// Show the cursor again
-		std::cout << "\033[?25h";
+	std::string_view row(int const y) const
+	{
+		return {cells.data() + index(y, 0), static_cast<size_t>(width)};
 	}
 
+	bool boundsCheck(Location const& location) const
+	{
+		return location.y() >= 0 && location.y() < height && location.x() >= 0 && location.x() < width;
+	}
 
-	Coordinate& get(int const y, int const x)
+	bool boundsCheck(Location const& current, Location const& dLocation) const
 	{
-		return data[y][x];
+		return boundsCheck(current.move(dLocation));
 	}
 
-	Coordinate& get(const Location& location)
+	// Every location of the grid, row by row
+	auto locations() const
 	{
-		return data[location.first][location.second];
+		return std::views::iota(0, width * height) |
+			std::views::transform([width = width](int const index) { return Location{index / width, index % width}; });
 	}
 
-	bool boundsCheck(Coordinate const& current, Location const& dLocation) const
+	GridView view() const
 	{
-		return boundsCheck(current, dLocation.first, dLocation.second);
+		return {cells.data() + index(0, 0), height, width, stride()};
 	}
 
-	bool boundsCheck(Coordinate const& current, int const dy, int const dx) const
+	GridView mirrorVertical() const
 	{
-		auto const yNext = current.y() + dy;
-		auto const xNext = current.x() + dx;
+		return view().mirrorVertical();
+	}
 
-		return yNext >= 0 && yNext < yMax() && xNext >= 0 && xNext < xMax();
+	GridView mirrorHorizontal() const
+	{
+		return view().mirrorHorizontal();
 	}
 
+	GridView transpose() const
+	{
+		return view().transpose();
+	}
 
-	Coordinate& get(Coordinate const& current, Location const& dLocation)
+	int xMax() const
 	{
-		return get(current, dLocation.first, dLocation.second);
+		return width;
 	}
 
-	Coordinate& get(Coordinate const& current, int const dy, int const dx)
+	int yMax() const
 	{
-		return data[current.y() + dy][current.x() + dx];
+		return height;
 	}
 
-	Grid mirrorVertical() const
+	int size() const
 	{
-		Grid mirrored{{}, false};
-		mirrored.data.resize(data.size());
-		int y = 0;
-		for (auto const& line : data)
-		{
-			for (auto const& coordinate : line | std::views::reverse)
-			{
-				mirrored.data[y].push_back(coordinate);
-			}
-			++y;
-		}
-		return mirrored;
+		return xMax() * yMax();
 	}
 
-	Grid mirrorHorizontal() const
+	static auto const& getSurroundingLocations()
 	{
-		Grid mirrored{{}, false};
-		mirrored.data.resize(yMax());
-		for (auto& line : mirrored.data)
-			line.resize(xMax());
+		return orthogonalMoves;
+	}
 
-		for (auto y : range(yMax()))
-			for (auto x : range(xMax()))
-				mirrored.data[yMax() - y - 1][x] = data[y][x];
+	// The cells next to location that are in the grid, found while iterating
+	auto getNeighbours(Location const& location) const
+	{
+		return orthogonalMoves |
+			std::views::transform([location](Location const& move) { return location.move(move); }) |
+			std::views::filter([this](Location const& neighbour) { return boundsCheck(neighbour); });
+	}
 
-		return mirrored;
+private:
+	int stride() const
+	{
+		return width + 2 * padding;
+	}
+
+	size_t index(int const y, int const x) const
+	{
+		assert(y >= -padding && y < height + padding && x >= -padding && x < width + padding);
+		return static_cast<size_t>(y + padding) * stride() + x + padding;
 	}
 
-	Grid transpose() const
+	size_t index(Location const& location) const
 	{
-		Grid mirrored{{}, false};
-		mirrored.data.resize(data[0].size());
-		for (auto& line : mirrored.data)
-			line.resize(data.size());
+		return index(static_cast<int>(location.y()), static_cast<int>(location.x()));
+	}
 
-		int y = 0;
-		for (auto const& line : data)
+	int width{0};
+	int height{0};
+	int padding{0};
+	std::vector<char> cells;
+	std::vector<int> values;
+};
+
+// One bit per cell, 64 cells to a word, every row starting on a new word. Whole grids are combined and shifted a word at
+// a time, so a question about every cell, like which cells have a set neighbour, costs a few instructions per 64 cells.
+class BitGrid
+{
+public:
+	BitGrid() = default;
+
+	BitGrid(int const yMax, int const xMax) :
+		width(xMax),
+		height(yMax),
+		wordsPerRow((xMax + 63) / 64),
+		words(static_cast<size_t>(wordsPerRow) * yMax)
+	{
+	}
+
+	bool test(int const y, int const x) const
+	{
+		return (words[wordIndex(y, x)] >> (x % 64)) & 1;
+	}
+
+	bool test(Location const& location) const
+	{
+		return test(static_cast<int>(location.y()), static_cast<int>(location.x()));
+	}
+
+	void set(int const y, int const x)
+	{
+		words[wordIndex(y, x)] |= uint64_t{1} << (x % 64);
+	}
+
+	void set(Location const& location)
+	{
+		set(static_cast<int>(location.y()), static_cast<int>(location.x()));
+	}
+
+	void reset(int const y, int const x)
+	{
+		words[wordIndex(y, x)] &= ~(uint64_t{1} << (x % 64));
+	}
+
+	void reset(Location const& location)
+	{
+		reset(static_cast<int>(location.y()), static_cast<int>(location.x()));
+	}
+
+	void clear()
+	{
+		std::ranges::fill(words, 0);
+	}
+
+	long long count() const
+	{
+		long long result = 0;
+		for (auto const word : words)
+			result += std::popcount(word);
+		return result;
+	}
+
+	bool any() const
+	{
+		return std::ranges::any_of(words, [](uint64_t const word) { return word != 0; });
+	}
+
+	// Every bit moved dy rows down and dx columns right (|dx| < 64). Bits moved off the grid are lost.
+	BitGrid shifted(int const dy, int const dx) const
+	{
+		assert(dx > -64 && dx < 64);
+		BitGrid result{height, width};
+		auto const first = std::clamp(dy, 0, height);
+		for (auto const y : range(first, std::clamp(height + dy, first, height)))
 		{
-			int x = 0;
-			for (auto const& coordinate : line | std::views::reverse)
+			auto const from = words.data() + static_cast<size_t>(y - dy) * wordsPerRow;
+			auto const to = result.words.data() + static_cast<size_t>(y) * wordsPerRow;
+			for (auto const word : range(wordsPerRow))
 			{
-				mirrored.data[x][y] = coordinate;
-				++x;
+				if (dx >= 0)
+					to[word] = (from[word] << dx) | (dx > 0 && word > 0 ? from[word - 1] >> (64 - dx) : 0);
+				else
+					to[word] = (from[word] >> -dx) | (word + 1 < wordsPerRow ? from[word + 1] << (64 + dx) : 0);
 			}
-			++y;
 		}
-		return mirrored;
+		result.clearPadding();
+		return result;
 	}
 
-	int xMax() const
+	// The cells with a set cell above, below, left or right of them
+	BitGrid neighbours() const
 	{
-		return data[0].size();
+		return shifted(1, 0) | shifted(-1, 0) | shifted(0, 1) | shifted(0, -1);
 	}
 
-	int yMax() const
+	BitGrid& operator&=(BitGrid const& other)
 	{
-		return data.size();
+		for (auto const index : range(words.size()))
+			words[index] &= other.words[index];
+		return *this;
 	}
 
-	int size() const
+	BitGrid& operator|=(BitGrid const& other)
 	{
-		return xMax() * yMax();
+		for (auto const index : range(words.size()))
+			words[index] |= other.words[index];
+		return *this;
+	}
+
+	BitGrid& operator^=(BitGrid const& other)
+	{
+		for (auto const index : range(words.size()))
+			words[index] ^= other.words[index];
+		return *this;
+	}
+
+	friend BitGrid operator&(BitGrid left, BitGrid const& right)
+	{
+		return left &= right;
+	}
+
+	friend BitGrid operator|(BitGrid left, BitGrid const& right)
+	{
+		return left |= right;
 	}
 
-	static auto getSurroundingLocations()
+	friend BitGrid operator^(BitGrid left, BitGrid const& right)
 	{
-		return std::vector<Location>({{-1, 0}, {1, 0}, {0, 1}, {0, -1}});
+		return left ^= right;
 	}
 
-	auto getSurroundingCoordinates(Coordinate const& coordinate)
+	BitGrid operator~() const
 	{
-		std::vector<Coordinate*> result;
-		for (auto const& surroundingLocation : getSurroundingLocations())
-			if (boundsCheck(coordinate, surroundingLocation))
-				result.push_back(&get(coordinate, surroundingLocation));
+		auto result = *this;
+		for (auto& word : result.words)
+			word = ~word;
+		result.clearPadding();
 		return result;
 	}
 
-	std::vector<std::vector<Coordinate>> data;
+	bool operator==(BitGrid const&) const = default;
+
+	int xMax() const
+	{
+		return width;
+	}
+
+	int yMax() const
+	{
+		return height;
+	}
+
+private:
+	size_t wordIndex(int const y, int const x) const
+	{
+		assert(y >= 0 && y < height && x >= 0 && x < width);
+		return static_cast<size_t>(y) * wordsPerRow + x / 64;
+	}
+
+	// The bits past the end of each row stay 0, so counts and comparisons don't see them
+	void clearPadding()
+	{
+		if (width % 64 == 0)
+			return;
+		auto const mask = (uint64_t{1} << (width % 64)) - 1;
+		for (auto const y : range(height))
+			words[static_cast<size_t>(y) * wordsPerRow + wordsPerRow - 1] &= mask;
+	}
+
+	int width{0};
+	int height{0};
+	int wordsPerRow{0};
+	std::vector<uint64_t> words;
 };
 
+// Cells by location. Normally they are kept in a Grid, so a lookup is an index calculation. A sparse map (see sparse)
+// hashes the locations that were set instead, for coordinates without known bounds; its other cells read as empty.
 class GridMap
 {
 public:
-	GridMap(std::vector<std::string> const& input, bool const convertToInt)
+	GridMap(std::ranges::sized_range auto const& input, bool const convertToInt,
+	        std::optional<char> const border = std::nullopt) :
+		dense(std::in_place, input, convertToInt, border)
 	{
-		int y = 0;
-		for (auto const& line : input)
+	}
+
+	GridMap(int const yMax, int const xMax, char const fill, std::optional<char> const border = std::nullopt) :
+		dense(std::in_place, yMax, xMax, fill, border)
+	{
+	}
+
+	static GridMap sparse(char const empty = '.')
+	{
+		return GridMap{empty};
+	}
+
+	char at(Location const& location) const
+	{
+		if (dense)
+			return dense->get(location);
+		auto const found = sparseCells.find(location);
+		return found != sparseCells.end() ? found->second : empty;
+	}
+
+	void set(Location const& location, char const value)
+	{
+		if (dense)
 		{
-			int x = 0;
-			for (auto const& ch : line)
-			{
-				map[{y, x}] = Coordinate{std::string{ch}, x, y, convertToInt};
-				++x;
-			}
-			++y;
+			dense->get(location) = value;
+			return;
 		}
+
+		if (sparseCells.empty())
+			lowest = highest = location;
+		lowest = {(std::min)(lowest.y(), location.y()), (std::min)(lowest.x(), location.x())};
+		highest = {(std::max)(highest.y(), location.y()), (std::max)(highest.x(), location.x())};
+		sparseCells[location] = value;
 	}
 
-	GridMap(int const yMax, int const xMax, std::string const& fill)
+	// The first location holding value, row by row for dense maps
+	std::optional<Location> find(char const value) const
 	{
-		for (auto const y : range(yMax))
-			for (auto const x : range(xMax))
-				map[{y, x}] = Coordinate{fill, x, y, false};
+		if (dense)
+		{
+			for (auto const location : dense->locations())
+				if (dense->get(location) == value)
+					return location;
+			return std::nullopt;
+		}
+
+		for (auto const& [location, cell] : sparseCells)
+			if (cell == value)
+				return location;
+		return std::nullopt;
 	}
 
 	bool boundsCheck(Location const& location) const
 	{
-		return map.contains(location);
+		return dense ? dense->boundsCheck(location) : sparseCells.contains(location);
 	}
 
 	bool boundsCheck(Location const& current, Location const& move) const
@@ -376,89 +855,608 @@ public:
 		return boundsCheck(current.move(move));
 	}
 
-	static auto getMoves()
+	static auto const& getMoves()
 	{
-		return std::vector<Location>({{-1, 0}, {1, 0}, {0, 1}, {0, -1}});
+		return orthogonalMoves;
 	}
 
+	// The moves from location that stay on the map, found while iterating
 	auto getSurroundingLocations(Location const& location) const
 	{
-		std::vector<Location> result;
-		for (auto const& surroundingLocation : getMoves())
-			if (boundsCheck(location, surroundingLocation))
-				result.push_back(surroundingLocation);
-		return result;
+		return orthogonalMoves |
+			std::views::filter([this, location](Location const& move) { return boundsCheck(location, move); });
 	}
 
+	// The highest x and y in use, not the width and height
 	long long xMax() const
 	{
-		for (auto const& location : map | std::views::reverse | std::views::keys)
-			return location.x();
-		return {};
+		return dense ? dense->xMax() - 1 : highest.x();
 	}
 
 	long long yMax() const
 	{
-		for (auto const& location : map | std::views::reverse | std::views::keys)
-			return location.y();
-		return {};
+		return dense ? dense->yMax() - 1 : highest.y();
 	}
 
 	void draw() const
 	{
-		std::cout << "\n";
-		for (auto const y : range(yMax() + 1))
+		auto const top = dense ? 0 : lowest.y();
+		auto const left = dense ? 0 : lowest.x();
+		FrameRenderer::instance().draw(static_cast<int>(yMax() - top + 1), static_cast<int>(xMax() - left + 1),
+		                               [&](int const y, int const x) { return at({top + y, left + x}); });
+	}
+
+private:
+	explicit GridMap(char const empty) :
+		empty(empty)
+	{
+	}
+
+	std::optional<Grid> dense;
+	std::unordered_map<Location, char> sparseCells;
+	char empty{'.'};
+	Location lowest;
+	Location highest;
+};
+
+// Numbers the cells of a grid for GraphSearch, layers states per cell when a state is more than a cell (like a cell and
+// the direction it was entered in)
+struct GridStates
+{
+	int width;
+	int height;
+	int layers{1};
+
+	int size() const
+	{
+		return width * height * layers;
+	}
+
+	int id(Location const& location, int const layer = 0) const
+	{
+		return (static_cast<int>(location.y()) * width + static_cast<int>(location.x())) * layers + layer;
+	}
+
+	Location location(int const id) const
+	{
+		auto const cell = id / layers;
+		return {cell / width, cell % width};
+	}
+
+	int layer(int const id) const
+	{
+		return id % layers;
+	}
+};
+
+// Shortest paths over states numbered 0 to numStates - 1, for example the cells of a grid (see GridStates). A search
+// gets the start states and edges(state, edge), which calls edge(next, cost) for each step out of state. Given isGoal
+// it stops once nothing cheaper than the nearest goal is left, and returns that goal's cost. The arrays are kept
+// between searches and only the states a search reached are reset, so many small searches on a big graph stay cheap.
+// With keepPredecessors every predecessor on a shortest path is recorded instead of one, which gives a DAG of all
+// shortest paths. Its edges must then cost more than 0: a state has to be settled after all its predecessors for the
+// DAG to be complete when the state is counted (and a 0 cost cycle would not be a DAG at all).
+class GraphSearch
+{
+public:
+	static constexpr long long unreachable = LLONG_MAX;
+	static constexpr auto noGoal = [](int) { return false; }; // searches everything that can be reached
+
+	explicit GraphSearch(int const numStates, bool const keepPredecessors = false) :
+		keepPredecessors(keepPredecessors),
+		distances(numStates, unreachable),
+		settled(numStates, false),
+		firstPredecessor(numStates, -1)
+	{
+	}
+
+	// Every edge costs 1, whatever edges says
+	template <typename Edges, typename IsGoal = decltype(noGoal)>
+	long long bfs(std::span<int const> const starts, Edges&& edges, IsGoal const& isGoal = noGoal)
+	{
+		return dequeSearch(starts, edges, isGoal, true);
+	}
+
+	// Edges cost 0 or 1
+	template <typename Edges, typename IsGoal = decltype(noGoal)>
+	long long zeroOneBfs(std::span<int const> const starts, Edges&& edges, IsGoal const& isGoal = noGoal)
+	{
+		return dequeSearch(starts, edges, isGoal, false);
+	}
+
+	template <typename Edges, typename IsGoal = decltype(noGoal)>
+	long long dijkstra(std::span<int const> const starts, Edges&& edges, IsGoal const& isGoal = noGoal)
+	{
+		return heapSearch(starts, edges, [](int) { return 0ll; }, isGoal);
+	}
+
+	// heuristic(state) may not overestimate the cost to the nearest goal, nor drop by more than an edge costs
+	template <typename Edges, typename Heuristic, typename IsGoal>
+	long long aStar(std::span<int const> const starts, Edges&& edges, Heuristic&& heuristic, IsGoal&& isGoal)
+	{
+		return heapSearch(starts, edges, heuristic, isGoal);
+	}
+
+	long long distance(int const state) const
+	{
+		return distances[state];
+	}
+
+	// The states whose shortest paths are known, in the order they were found
+	std::span<int const> settledStates() const
+	{
+		return order;
+	}
+
+	template <typename Function>
+	void forEachPredecessor(int const state, Function&& function) const
+	{
+		for (auto link = firstPredecessor[state]; link != -1; link = predecessors[link].next)
+			function(predecessors[link].state);
+	}
+
+	// A shortest path from a start to target, empty if there is none
+	std::vector<int> path(int target) const
+	{
+		std::vector<int> result;
+		if (distances[target] == unreachable)
+			return result;
+		result.push_back(target);
+		while (firstPredecessor[target] != -1)
+		{
+			target = predecessors[firstPredecessor[target]].state;
+			result.push_back(target);
+		}
+		std::ranges::reverse(result);
+		return result;
+	}
+
+	// Every state on a shortest path to one of targets, following the predecessor DAG back
+	std::vector<int> statesOnShortestPaths(std::span<int const> const targets) const
+	{
+		std::vector<bool> marked(distances.size(), false);
+		std::vector<int> result;
+		for (auto const target : targets)
+		{
+			if (distances[target] != unreachable && !marked[target])
+			{
+				marked[target] = true;
+				result.push_back(target);
+			}
+		}
+		for (size_t index = 0; index < result.size(); ++index)
+		{
+			forEachPredecessor(result[index], [&](int const predecessor)
+			{
+				if (!marked[predecessor])
+				{
+					marked[predecessor] = true;
+					result.push_back(predecessor);
+				}
+			});
+		}
+		return result;
+	}
+
+	// How many shortest paths lead from the starts to each settled state. Needs keepPredecessors and a search that
+	// settles states in order of distance, so not aStar: there a successor can tie with its predecessor on estimated
+	// cost and be settled first, and predecessors found after it was counted are missed.
+	std::vector<long long> countShortestPaths() const
+	{
+		std::vector<long long> counts(distances.size(), 0);
+		for (auto const state : order)
+		{
+			if (firstPredecessor[state] == -1)
+				counts[state] = 1;
+			forEachPredecessor(state, [&](int const predecessor) { counts[state] += counts[predecessor]; });
+		}
+		return counts;
+	}
+
+private:
+	struct Predecessor
+	{
+		int state;
+		int next;
+	};
+
+	struct Queued
+	{
+		long long priority;
+		int state;
+
+		bool operator>(Queued const& other) const
+		{
+			return priority > other.priority;
+		}
+	};
+
+	void begin(std::span<int const> const starts)
+	{
+		for (auto const state : touched)
+		{
+			distances[state] = unreachable;
+			settled[state] = false;
+			firstPredecessor[state] = -1;
+		}
+		touched.clear();
+		order.clear();
+		predecessors.clear();
+
+		for (auto const start : starts)
+		{
+			if (distances[start] == unreachable)
+				touched.push_back(start);
+			distances[start] = 0;
+		}
+	}
+
+	// Records the step from `from` to `to` costing cost in total, returns whether that made `to` cheaper
+	bool relax(int const from, int const to, long long const cost)
+	{
+		assert(!keepPredecessors || cost > distances[from]);
+		auto const improved = cost < distances[to];
+		if (improved)
+		{
+			if (distances[to] == unreachable)
+				touched.push_back(to);
+			distances[to] = cost;
+			firstPredecessor[to] = -1;
+		}
+		else if (cost > distances[to] || !keepPredecessors)
+			return false;
+
+		predecessors.push_back({from, firstPredecessor[to]});
+		firstPredecessor[to] = static_cast<int>(predecessors.size()) - 1;
+		return improved;
+	}
+
+	template <typename Edges, typename IsGoal>
+	long long dequeSearch(std::span<int const> const starts, Edges& edges, IsGoal& isGoal, bool const unitCosts)
+	{
+		begin(starts);
+		frontier.assign(starts.begin(), starts.end());
+		auto goalCost = unreachable;
+		while (!frontier.empty())
+		{
+			auto const state = frontier.front();
+			frontier.pop_front();
+			if (settled[state])
+				continue;
+
+			auto const cost = distances[state];
+			if (cost > goalCost)
+				break;
+			settled[state] = true;
+			order.push_back(state);
+			if (goalCost == unreachable && isGoal(state))
+				goalCost = cost;
+
+			edges(state, [&](int const next, long long edgeCost)
+			{
+				if (unitCosts)
+					edgeCost = 1;
+				assert(edgeCost == 0 || edgeCost == 1);
+				if (relax(state, next, cost + edgeCost))
+				{
+					if (edgeCost == 0)
+						frontier.push_front(next);
+					else
+						frontier.push_back(next);
+				}
+			});
+		}
+		frontier.clear();
+		return goalCost;
+	}
+
+	template <typename Edges, typename Heuristic, typename IsGoal>
+	long long heapSearch(std::span<int const> const starts, Edges& edges, Heuristic&& heuristic, IsGoal& isGoal)
+	{
+		begin(starts);
+		heap.clear();
+		for (auto const start : starts)
+			heap.push_back({heuristic(start), start});
+		std::ranges::make_heap(heap, std::greater{});
+
+		auto goalCost = unreachable;
+		while (!heap.empty())
+		{
+			std::ranges::pop_heap(heap, std::greater{});
+			auto const [priority, state] = heap.back();
+			heap.pop_back();
+			if (settled[state])
+				continue;
+			if (priority > goalCost)
+				break;
+
+			auto const cost = distances[state];
+			settled[state] = true;
+			order.push_back(state);
+			if (goalCost == unreachable && isGoal(state))
+				goalCost = cost;
+
+			edges(state, [&](int const next, long long const edgeCost)
+			{
+				assert(edgeCost >= 0);
+				if (relax(state, next, cost + edgeCost))
+				{
+					heap.push_back({cost + edgeCost + heuristic(next), next});
+					std::ranges::push_heap(heap, std::greater{});
+				}
+			});
+		}
+		heap.clear();
+		return goalCost;
+	}
+
+	bool keepPredecessors;
+	std::vector<long long> distances;
+	std::vector<bool> settled;
+	std::vector<int> firstPredecessor; // into predecessors, -1 for none
+	std::vector<Predecessor> predecessors; // linked lists, one per state
+	std::vector<int> touched;
+	std::vector<int> order;
+	std::deque<int> frontier;
+	std::vector<Queued> heap;
+};
+
+// Connected regions of a grid: cells belong together when a path of orthogonal neighbours leads from one to the other
+// with same(cell, neighbour) holding at every step. Labels are found with union-find in two passes over the rows, not
+// with a flood fill, so there is no recursion and the cells are read in memory order. Labels count from 0 in the order
+// their first cell comes up row by row. For every label the area, the bounding box and the cells are kept.
+class ComponentLabels
+{
+public:
+	template <typename Same = std::equal_to<>>
+	explicit ComponentLabels(Grid const& grid, Same const& same = {})
+	{
+		build(grid, same, (std::max)(grid.yMax(), 1), nullptr);
+	}
+
+	// The same labels, found for bands of tileRows rows at the same time on the pool the caller works for, or else on a
+	// pool of its own. Labels of neighbouring bands are merged along the seams between them afterwards.
+	template <typename Same = std::equal_to<>>
+	static ComponentLabels parallel(Grid const& grid, Same const& same = {}, int const tileRows = 256)
+	{
+		ComponentLabels components;
+		if (grid.yMax() <= tileRows)
 		{
-			for (auto const x : range(xMax() + 1))
+			components.build(grid, same, (std::max)(grid.yMax(), 1), nullptr);
+			return components;
+		}
+
+		std::optional<ThreadPool> ownPool;
+		auto pool = ThreadPool::current();
+		if (!pool)
+			pool = &ownPool.emplace();
+		components.build(grid, same, tileRows, pool);
+		return components;
+	}
+
+	int label(int const y, int const x) const
+	{
+		return labels[index(y, x)];
+	}
+
+	int label(Location const& location) const
+	{
+		return label(static_cast<int>(location.y()), static_cast<int>(location.x()));
+	}
+
+	int count() const
+	{
+		return static_cast<int>(boxes.size());
+	}
+
+	int area(int const label) const
+	{
+		return starts[label + 1] - starts[label];
+	}
+
+	// The lowest and the highest location of the label
+	std::pair<Location, Location> const& bounds(int const label) const
+	{
+		return boxes[label];
+	}
+
+	// The cells of the label, row by row
+	auto cells(int const label) const
+	{
+		return std::span{cellIndices}.subspan(starts[label], area(label)) |
+			std::views::transform([width = width](int const cell) { return Location{cell / width, cell % width}; });
+	}
+
+private:
+	ComponentLabels() = default;
+
+	template <typename Same>
+	void build(Grid const& grid, Same const& same, int const tileRows, ThreadPool* const pool)
+	{
+		width = grid.xMax();
+		height = grid.yMax();
+		labels.assign(static_cast<size_t>(width) * height, 0);
+
+		// Labels that are unique within their band
+		auto const numBands = (std::max)((height + tileRows - 1) / tileRows, 1);
+		std::vector<int> offsets(numBands + 1, 0);
+		forEachBand(numBands, pool, [&](int const band)
+		{
+			offsets[band + 1] = labelBand(grid, same, band * tileRows, (std::min)(height, (band + 1) * tileRows));
+		});
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+		// Joined across the seams, then numbered in order of their first cell
+		std::vector<int> parent(offsets.back());
+		std::iota(parent.begin(), parent.end(), 0);
+		for (auto const band : range(1, numBands))
+		{
+			auto const y = band * tileRows;
+			for (auto const x : range(width))
+				if (same(grid.get(y - 1, x), grid.get(y, x)))
+					unite(parent, offsets[band - 1] + label(y - 1, x), offsets[band] + label(y, x));
+		}
+		auto const numLabels = numberRoots(parent);
+
+		forEachBand(numBands, pool, [&](int const band)
+		{
+			auto const begin = labels.begin() + index(band * tileRows, 0);
+			auto const end = labels.begin() + index((std::min)(height, (band + 1) * tileRows), 0);
+			for (auto& cell : std::ranges::subrange(begin, end))
+				cell = parent[offsets[band] + cell];
+		});
+
+		// Cells grouped by label with a counting sort
+		starts.assign(numLabels + 1, 0);
+		boxes.assign(numLabels, {{INT_MAX, INT_MAX}, {INT_MIN, INT_MIN}});
+		for (auto const y : range(height))
+		{
+			for (auto const x : range(width))
 			{
-				std::cout << map.at({y, x}).strValue;
+				auto const cellLabel = label(y, x);
+				++starts[cellLabel + 1];
+				auto& [lowest, highest] = boxes[cellLabel];
+				lowest = {(std::min)(lowest.first, y), (std::min)(lowest.second, x)};
+				highest = {(std::max)(highest.first, y), (std::max)(highest.second, x)};
 			}
-			std::cout << "\n";
 		}
-		return;
+		std::partial_sum(starts.begin(), starts.end(), starts.begin());
+		cellIndices.resize(labels.size());
+		auto next = starts;
+		for (auto const cell : range(static_cast<int>(labels.size())))
+			cellIndices[next[labels[cell]]++] = cell;
+	}
 
-		static int previousLines = 0; // Track the number of lines previously drawn
-		int currentLines = yMax() + 2; // Calculate lines this draw will use
-		static std::unordered_map<std::string, int> colorMap; // Map characters to colors
-		static int colorIndex = 1; // Start assigning colors from 1
+	// First pass over the rows from top to bottom, every cell gets the label of the neighbour to its left or above it
+	// if it belongs with one. Labels that turn out to meet are united. Leaves dense labels local to the band and
+	// returns how many there are.
+	template <typename Same>
+	int labelBand(Grid const& grid, Same const& same, int const top, int const bottom)
+	{
+		std::vector<int> parent;
+		for (auto const y : range(top, bottom))
+		{
+			for (auto const x : range(width))
+			{
+				auto const cell = grid.get(y, x);
+				auto const cellIndex = index(y, x);
+				auto const joinsLeft = x > 0 && same(grid.get(y, x - 1), cell);
+				auto const joinsUp = y > top && same(grid.get(y - 1, x), cell);
+				if (joinsLeft)
+				{
+					labels[cellIndex] = labels[cellIndex - 1];
+					if (joinsUp)
+						unite(parent, labels[cellIndex], labels[cellIndex - width]);
+				}
+				else if (joinsUp)
+				{
+					labels[cellIndex] = labels[cellIndex - width];
+				}
+				else
+				{
+					labels[cellIndex] = static_cast<int>(parent.size());
+					parent.push_back(labels[cellIndex]);
+				}
+			}
+		}
 
-		// Hide the cursor
-		std::cout << "\033[?25l";
+		auto const numLabels = numberRoots(parent);
+		for (auto& cell : std::ranges::subrange(labels.begin() + index(top, 0), labels.begin() + index(bottom, 0)))
+			cell = parent[cell];
+		return numLabels;
+	}
 
-		// Move the cursor up by the number of lines previously drawn
-		if (previousLines > 0)
-			std::cout << "\033[" << previousLines << "A"; // Move cursor up
+	template <typename Function>
+	static void forEachBand(int const numBands, ThreadPool* const pool, Function const& function)
+	{
+		if (!pool)
+		{
+			for (auto const band : range(numBands))
+				function(band);
+			return;
+		}
 
-		std::cout << "\n";
-		for (auto const y : range(yMax()))
+		// Workers and the caller claim bands until none are left, then the caller waits for the ones still being
+		// labelled. It doesn't help through pool->wait: that could run another day's task here, in the middle of the
+		// phase the caller is measuring. Tasks that start after the last band was claimed return straight away, the
+		// shared counters outlive this call for them.
+		struct Bands
+		{
+			std::atomic<int> next{0};
+			std::atomic<int> done{0};
+			std::mutex mutex;
+			std::exception_ptr error;
+		};
+		auto const bands = std::make_shared<Bands>();
+		auto const claim = [bands, numBands, &function]
 		{
-			for (auto const x : range(xMax()))
+			for (auto band = bands->next++; band < numBands; band = bands->next++)
 			{
-				auto const& coordinate = map.at({y, x});
-				// Get the string to print
-				std::string value = (coordinate.intValue > -1)
-					                    ? std::to_string(coordinate.intValue)
-					                    : coordinate.strValue;
-
-				// Assign a color if not already assigned
-				if (!colorMap.contains(value))
-					colorMap[value] = 31 + (colorIndex++ % 6); // Cycle through 6 colors (3136)
-
-				// Print the value with its assigned color
-				std::cout << "\033[" << colorMap[value] << "m" << value << "\033[0m"; // Reset color after printing
+				try
+				{
+					function(band);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(bands->mutex);
+					if (!bands->error)
+						bands->error = std::current_exception();
+				}
+				if (++bands->done == numBands)
+					bands->done.notify_all();
 			}
-			std::cout << "\n";
+		};
+		for ([[maybe_unused]] auto _ : range((std::min)(numBands - 1, static_cast<int>(pool->size()))))
+			pool->submit(claim);
+		claim();
+		for (auto done = bands->done.load(); done < numBands; done = bands->done.load())
+			bands->done.wait(done);
+		if (bands->error)
+			std::rethrow_exception(bands->error);
+	}
+
+	static int find(std::vector<int>& parent, int label)
+	{
+		while (parent[label] != label)
+		{
+			parent[label] = parent[parent[label]];
+			label = parent[label];
 		}
-		std::cout << "\n";
+		return label;
+	}
 
-		// Update the count of previously drawn lines
-		previousLines = currentLines;
+	// The lower label becomes the root, so every root is the first label of its set
+	static void unite(std::vector<int>& parent, int const first, int const second)
+	{
+		auto const firstRoot = find(parent, first);
+		auto const secondRoot = find(parent, second);
+		if (firstRoot < secondRoot)
+			parent[secondRoot] = firstRoot;
+		else
+			parent[firstRoot] = secondRoot;
+	}
 
-		// Show the cursor again
-		std::cout << "\033[?25h";
+	// Replaces every entry with the number of its set, counting the roots in order. Whatever a label points to comes
+	// before it and is already replaced by then.
+	static int numberRoots(std::vector<int>& parent)
+	{
+		auto numRoots = 0;
+		for (auto const label : range(static_cast<int>(parent.size())))
+			parent[label] = parent[label] == label ? numRoots++ : parent[parent[label]];
+		return numRoots;
 	}
 
-	std::map<Location, Coordinate> map;
+	size_t index(int const y, int const x) const
+	{
+		return static_cast<size_t>(y) * width + x;
+	}
+
+	int width{0};
+	int height{0};
+	std::vector<int> labels;
+	std::vector<int> starts; // into cellIndices, one per label and one past the end
+	std::vector<int> cellIndices;
+	std::vector<std::pair<Location, Location>> boxes;
 };
 
 template <typename T>
@@ -478,10 +1476,15 @@ std::vector<std::vector<T>> add(std::vector<T> const& combination, int const num
 template <typename T>
 std::vector<std::vector<T>> const& generateCombinations(int const vectorSize, int const numOptions)
 {
+	// Parts may run at the same time. References stay valid when the map grows.
+	static std::shared_mutex mutex;
 	static std::map<std::pair<int, int>, std::vector<std::vector<T>>> cache;
 	auto const key = std::make_pair(vectorSize, numOptions);
-	if (cache.contains(key))
-		return cache.at(key);
+	{
+		std::shared_lock lock(mutex);
+		if (auto const it = cache.find(key); it != cache.end())
+			return it->second;
+	}
 
 	std::vector<std::vector<T>> combinations = add(std::vector<T>{}, numOptions);
 	while (combinations[0].size() < vectorSize)
@@ -493,11 +1496,153 @@ std::vector<std::vector<T>> const& generateCombinations(int const vectorSize, in
 		combinations = newCombinations;
 	}
 
-	cache[key] = combinations;
-	return cache[key];
+	std::unique_lock lock(mutex);
+	return cache.try_emplace(key, std::move(combinations)).first->second;
 }
 
 [[nodiscard]] inline bool equal(double a, double b)
 {
 	return std::abs(a - b) < DBL_EPSILON;
 }
+
+// Counters, gauges and timers for hot loops. Define AOC_INSTRUMENT to enable them, otherwise every call compiles
+// away. Names must be string literals. Recording is per thread, the runner collects what a part recorded on its
+// own thread after running it. Counters are declared once per call site, which finds their slot up front:
+//   static Instrumentation::Counter const nodesExpanded{"nodes expanded"};
+//   nodesExpanded.add();
+#ifdef AOC_INSTRUMENT
+inline constexpr bool instrumentationEnabled = true;
+#else
+inline constexpr bool instrumentationEnabled = false;
+#endif
+
+struct InstrumentationReport
+{
+	std::map<std::string_view, long long> counters;
+	std::map<std::string_view, long long> gauges; // highest value seen
+	std::map<std::string_view, std::chrono::nanoseconds> timers;
+
+	bool empty() const
+	{
+		return counters.empty() && gauges.empty() && timers.empty();
+	}
+};
+
+class Instrumentation
+{
+public:
+	// Counts into a slot of this thread's record, so adding is an index rather than a lookup by name
+	class Counter
+	{
+	public:
+		explicit Counter(std::string_view const name) :
+			slot(instrumentationEnabled ? counterSlot(name) : 0)
+		{
+		}
+
+		void add(long long const amount = 1) const
+		{
+			if constexpr (instrumentationEnabled)
+			{
+				auto& counts = current().counts;
+				if (slot >= counts.size())
+					counts.resize(slot + 1, 0);
+				counts[slot] += amount;
+			}
+		}
+
+	private:
+		size_t slot;
+	};
+
+	static void gauge(std::string_view const name, long long const value)
+	{
+		if constexpr (instrumentationEnabled)
+		{
+			auto& gauge = current().report.gauges.try_emplace(name, value).first->second;
+			gauge = (std::max)(gauge, value);
+		}
+	}
+
+	static void time(std::string_view const name, std::chrono::nanoseconds const duration)
+	{
+		if constexpr (instrumentationEnabled)
+			current().report.timers[name] += duration;
+	}
+
+	// Everything this thread recorded since the last call
+	static InstrumentationReport take()
+	{
+		auto& record = current();
+		auto report = std::exchange(record.report, {});
+		if (!record.counts.empty())
+		{
+			std::lock_guard lock(counterNamesMutex());
+			for (auto const slot : range(record.counts.size()))
+				if (record.counts[slot] != 0)
+					report.counters[counterNames()[slot]] = std::exchange(record.counts[slot], 0);
+		}
+		return report;
+	}
+
+private:
+	struct Record
+	{
+		InstrumentationReport report;
+		std::vector<long long> counts; // by counter slot
+	};
+
+	static Record& current()
+	{
+		thread_local Record record;
+		return record;
+	}
+
+	static size_t counterSlot(std::string_view const name)
+	{
+		std::lock_guard lock(counterNamesMutex());
+		auto& names = counterNames();
+		auto const it = std::ranges::find(names, name);
+		if (it != names.end())
+			return static_cast<size_t>(it - names.begin());
+		names.push_back(name);
+		return names.size() - 1;
+	}
+
+	static std::vector<std::string_view>& counterNames()
+	{
+		static std::vector<std::string_view> names;
+		return names;
+	}
+
+	static std::mutex& counterNamesMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+};
+
+// Adds the time until it goes out of scope to a timer
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(std::string_view const name) :
+		name(name)
+	{
+	}
+
+	ScopedTimer(ScopedTimer const&) = delete;
+	ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+	~ScopedTimer()
+	{
+		if constexpr (instrumentationEnabled)
+			Instrumentation::time(name, std::chrono::steady_clock::now() - start);
+	}
+
+private:
+	std::string_view const name;
+	std::chrono::steady_clock::time_point const start{
+		instrumentationEnabled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}
+	};
+};